@@ -0,0 +1,93 @@
+// bench_ready_queue.cpp
+// Created by Francesco on 17/02/2026.
+//
+// Micro-benchmark della selezione FPP: costo per tick in funzione dell'horizon.
+// - legacy: SchedulerFPP::select_job su tutti i job mai rilasciati (cresce con l'horizon)
+// - ready queue: Simulator (tick-loop) con ReadyQueueFPP (costo per tick costante)
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+#include "../include/simulator.hpp"
+#include "../include/scheduler.hpp"
+#include "../include/taskset_generator.hpp"
+
+namespace {
+
+using namespace rt;
+
+// Riproduce il tick-loop originale: jobs_ cresce e select_job scandisce tutto.
+tick_t legacy_tick_loop(const std::vector<Task>& tasks, tick_t horizon) {
+    std::vector<Job> jobs;
+    std::vector<int> counter(tasks.size(), 0);
+    tick_t busy = 0;
+
+    for (tick_t t = 0; t < horizon; ++t) {
+        for (std::int32_t ti = 0; ti < static_cast<std::int32_t>(tasks.size()); ++ti) {
+            if (tasks[ti].releases_at(t)) {
+                jobs.push_back(Job::from_task(tasks[ti], ti, t, counter[ti]++));
+            }
+        }
+        const int idx = SchedulerFPP::select_job(jobs, tasks, t);
+        if (idx >= 0) {
+            jobs[idx].execute_one_tick(t);
+            busy++;
+        }
+    }
+    return busy;
+}
+
+template <typename F>
+double ns_per_tick(tick_t horizon, F&& body) {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    const auto end = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return ns / static_cast<double>(horizon);
+}
+
+} // namespace
+
+int main() {
+    GeneratorConfig gcfg;
+    gcfg.n_tasks = 8;
+    gcfg.Tmin = 10;
+    gcfg.Tmax = 150;
+    gcfg.utilization_target = 0.85;
+    gcfg.seed = 1001;
+
+    const std::vector<Task> tasks = TaskSetGenerator::generate(gcfg);
+
+    std::cout << std::left
+              << std::setw(12) << "horizon"
+              << std::setw(20) << "legacy ns/tick"
+              << std::setw(20) << "ready-queue ns/tick"
+              << "\n";
+    std::cout << std::string(12 + 20 + 20, '-') << "\n";
+
+    for (tick_t horizon : {1000, 5000, 20000, 50000}) {
+        volatile tick_t sink = 0;
+
+        const double legacy = ns_per_tick(horizon, [&] {
+            sink = legacy_tick_loop(tasks, horizon);
+        });
+
+        const double queued = ns_per_tick(horizon, [&] {
+            Simulator sim(tasks, horizon, SimEngine::Tick);
+            sim.run(false, false, false);
+            sink = sim.metrics().busy_ticks;
+        });
+
+        std::cout << std::left
+                  << std::setw(12) << horizon
+                  << std::setw(20) << std::fixed << std::setprecision(1) << legacy
+                  << std::setw(20) << std::fixed << std::setprecision(1) << queued
+                  << "\n";
+        (void)sink;
+    }
+
+    return 0;
+}
@@ -0,0 +1,433 @@
+// bench_suite.cpp
+// Created by Francesco on 17/02/2026.
+//
+// Suite di benchmark per gli hot path del simulatore, con seed fissi per confronti
+// tra release successive:
+// - SchedulerFPP::select_job (scansione lineare e ready queue)
+// - Simulator::run (tick ed event engine) a diversi horizon e numeri di task, e con
+//   istogrammi per task attivi (set_histograms)
+// - BasicSimulator<Policy>::run per le politiche FPP, DM, EDF, LLF
+// - LockstepSimulator (task set in lockstep sulle lane SIMD) contro Simulator per set
+// - GlobalSimulator e PartitionedSimulator (FPP su 8 core)
+// - breakdown_search (ricerca del fattore di scala critico dei WCET, senza RTA)
+// - StopConditions (costo delle condizioni non soddisfatte, stop al primo miss)
+// - Simulator::run con traccia binaria (ring buffer) e con timeline testuale
+// - TaskSetGenerator::generate / generate_batch, hyperperiod
+// - export CSV (append_*_csv e CsvExporter)
+// Per ogni caso riporta ns/op (un'operazione = una chiamata misurata) e, dove ha senso,
+// ticks/s e jobs/s. Le operazioni molto brevi sono ripetute in blocco per ogni run
+// così che il costo del cronometro non domini la misura.
+//
+// Uso: bench_suite [filtro]   (esegue solo i casi il cui nome contiene il filtro)
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <sstream>
+
+#include "../include/simulator.hpp"
+#include "../include/lockstep_simulator.hpp"
+#include "../include/multiprocessor.hpp"
+#include "../include/sensitivity.hpp"
+#include "../include/scheduler.hpp"
+#include "../include/ready_queue.hpp"
+#include "../include/taskset_generator.hpp"
+#include "../include/time_utils.hpp"
+#include "../include/csv_export.hpp"
+
+namespace {
+
+using namespace rt;
+
+// Lavoro svolto da una singola esecuzione del corpo del benchmark.
+struct Work {
+    double ticks = 0.0;
+    double jobs = 0.0;
+    double ops = 1.0;
+};
+
+struct BenchCase {
+    std::string name;
+    std::function<Work()> body;
+};
+
+// Ripete il corpo fino a superare `min_seconds` (almeno una volta) e stampa una riga.
+void run_case(const BenchCase& bc, double min_seconds = 0.3) {
+    using clock = std::chrono::steady_clock;
+
+    std::int64_t runs = 0;
+    Work total{0.0, 0.0, 0.0};
+    const auto start = clock::now();
+    double elapsed = 0.0;
+
+    do {
+        const Work w = bc.body();
+        total.ticks += w.ticks;
+        total.jobs += w.jobs;
+        total.ops += w.ops;
+        runs++;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < min_seconds);
+
+    const double ns_per_op = 1e9 * elapsed / total.ops;
+
+    std::cout << std::left << std::setw(40) << bc.name
+              << std::right << std::setw(10) << runs
+              << std::setw(16) << std::fixed << std::setprecision(1) << ns_per_op;
+
+    if (total.ticks > 0.0) {
+        std::cout << std::setw(16) << std::setprecision(3) << (total.ticks / elapsed) / 1e6;
+    } else {
+        std::cout << std::setw(16) << "-";
+    }
+    if (total.jobs > 0.0) {
+        std::cout << std::setw(16) << std::setprecision(3) << (total.jobs / elapsed) / 1e6;
+    } else {
+        std::cout << std::setw(16) << "-";
+    }
+    std::cout << "\n";
+}
+
+std::vector<Task> make_taskset(std::int32_t n_tasks, std::uint32_t seed, std::int32_t cores = 1) {
+    GeneratorConfig gcfg;
+    gcfg.n_tasks = n_tasks;
+    gcfg.Tmin = 10;
+    // Con molti task si allargano i periodi per non saturare la CPU con C >= 1.
+    gcfg.Tmax = std::max<tick_t>(150, 40 * n_tasks / cores);
+    gcfg.utilization_target = 0.85 * cores;
+    gcfg.seed = seed;
+    return TaskSetGenerator::generate(gcfg);
+}
+
+double total_jobs(const SimulationMetrics& m) {
+    double jobs = 0.0;
+    for (const auto& tm : m.per_task) jobs += static_cast<double>(tm.jobs_released);
+    return jobs;
+}
+
+std::vector<BenchCase> build_cases(const std::filesystem::path& tmp_dir) {
+    std::vector<BenchCase> cases;
+
+    // --- Selezione FPP: N job pronti, metà completati ---
+    constexpr int select_batch = 1000;
+    for (std::int32_t n_jobs : {16, 256, 4096}) {
+        auto tasks = std::make_shared<std::vector<Task>>(make_taskset(8, 42));
+        auto jobs = std::make_shared<std::vector<Job>>();
+        auto ready = std::make_shared<ReadyQueueFPP>(*tasks);
+        for (std::int32_t k = 0; k < n_jobs; ++k) {
+            const std::int32_t ti = k % 8;
+            Job j = Job::from_task((*tasks)[ti], ti, k, k / 8);
+            if (k % 2 == 1) {
+                j.remaining_time = 0;
+            } else {
+                ready->push(ti, jobs->size());
+            }
+            jobs->push_back(j);
+        }
+
+        cases.push_back({"select_job/scan/jobs=" + std::to_string(n_jobs), [=] {
+            for (int k = 0; k < select_batch; ++k) {
+                volatile int idx = SchedulerFPP::select_job(*jobs, *tasks, n_jobs);
+                (void)idx;
+            }
+            return Work{0.0, 0.0, select_batch};
+        }});
+        cases.push_back({"select_job/ready_queue/jobs=" + std::to_string(n_jobs), [=] {
+            for (int k = 0; k < select_batch; ++k) {
+                volatile int idx = SchedulerFPP::select_job(*ready);
+                (void)idx;
+            }
+            return Work{0.0, 0.0, select_batch};
+        }});
+    }
+
+    // --- Simulator::run: horizon e numero di task ---
+    for (SimEngine engine : {SimEngine::Tick, SimEngine::Event}) {
+        const std::string eng = (engine == SimEngine::Tick) ? "tick" : "event";
+
+        for (tick_t horizon : {1000, 10000, 100000}) {
+            auto tasks = std::make_shared<std::vector<Task>>(make_taskset(8, 1001));
+            cases.push_back({"simulate/" + eng + "/n=8/h=" + std::to_string(horizon), [=] {
+                Simulator sim(*tasks, horizon, engine);
+                sim.run(false, false, false);
+                return Work{static_cast<double>(horizon), total_jobs(sim.metrics())};
+            }});
+        }
+
+        for (std::int32_t n_tasks : {4, 32, 256, 1024}) {
+            auto tasks = std::make_shared<std::vector<Task>>(make_taskset(n_tasks, 2001));
+            const tick_t horizon = 20000;
+            cases.push_back({"simulate/" + eng + "/n=" + std::to_string(n_tasks) + "/h=20000", [=] {
+                Simulator sim(*tasks, horizon, engine);
+                sim.run(false, false, false);
+                return Work{static_cast<double>(horizon), total_jobs(sim.metrics())};
+            }});
+        }
+    }
+
+    // Costo degli istogrammi per task (confronto con simulate/event/n=32/h=20000).
+    {
+        auto tasks = std::make_shared<std::vector<Task>>(make_taskset(32, 2001));
+        const tick_t horizon = 20000;
+        cases.push_back({"simulate/event_histograms/n=32/h=20000", [=] {
+            Simulator sim(*tasks, horizon, SimEngine::Event);
+            sim.set_histograms(true);
+            sim.run(false, false, false);
+            return Work{static_cast<double>(horizon), total_jobs(sim.metrics())};
+        }});
+    }
+
+    // --- Politiche di scheduling: stesso task set, event engine ---
+    {
+        auto tasks = std::make_shared<std::vector<Task>>(make_taskset(32, 2001));
+        const tick_t horizon = 100000;
+        auto add_policy = [&](auto policy) {
+            using P = decltype(policy);
+            cases.push_back({std::string("simulate/policy=") + P::name + "/n=32/h=100000", [=] {
+                BasicSimulator<P> sim(*tasks, horizon, SimEngine::Event);
+                sim.run(false, false, false);
+                return Work{static_cast<double>(horizon), total_jobs(sim.metrics())};
+            }});
+        };
+        add_policy(PolicyFPP{});
+        add_policy(PolicyDM{});
+        add_policy(PolicyEDF{});
+        add_policy(PolicyLLF{});
+    }
+
+    // --- Traccia: ring buffer binario contro timeline testuale (su stream scartato) ---
+    {
+        auto tasks = std::make_shared<std::vector<Task>>(make_taskset(8, 1001));
+        const tick_t horizon = 100000;
+        auto trace = std::make_shared<TraceRecorder>();
+        cases.push_back({"trace/binary/n=8/h=100000", [=] {
+            Simulator sim(*tasks, horizon, SimEngine::Event);
+            sim.set_trace(trace.get());
+            sim.run(false, false, false);
+            return Work{static_cast<double>(horizon), total_jobs(sim.metrics())};
+        }});
+        cases.push_back({"trace/text/n=8/h=100000", [=] {
+            std::ostringstream sink;
+            auto* old = std::cout.rdbuf(sink.rdbuf());
+            Simulator sim(*tasks, horizon, SimEngine::Event);
+            sim.run(true, false, false);
+            std::cout.rdbuf(old);
+            return Work{static_cast<double>(horizon), total_jobs(sim.metrics())};
+        }});
+    }
+
+    // --- Multiprocessore: 256 task su 8 core (utilizzazione 0.85 per core) ---
+    for (SimEngine engine : {SimEngine::Tick, SimEngine::Event}) {
+        const std::string eng = (engine == SimEngine::Tick) ? "tick" : "event";
+        auto tasks = std::make_shared<std::vector<Task>>(make_taskset(256, 6001, 8));
+        const tick_t horizon = 20000;
+        cases.push_back({"multicore/global_" + eng + "/m=8/n=256/h=20000", [=] {
+            GlobalSimulator<PolicyFPP> sim(*tasks, horizon, 8, engine);
+            sim.run(false, false);
+            return Work{static_cast<double>(horizon), total_jobs(sim.metrics())};
+        }});
+        cases.push_back({"multicore/partitioned_" + eng + "/m=8/n=256/h=20000", [=] {
+            PartitionedSimulator<PolicyFPP> sim(*tasks, horizon, 8, PartitionHeuristic::FirstFit, engine);
+            sim.run(false, false);
+            return Work{static_cast<double>(horizon), total_jobs(sim.metrics())};
+        }});
+    }
+
+    // --- Multiprocessore sovraccarico: backlog crescente, la selezione non deve scorrerlo ---
+    {
+        auto tasks = std::make_shared<std::vector<Task>>();
+        for (int i = 0; i < 4; ++i) {
+            Task t;
+            t.id = i;
+            t.period = (i < 3) ? 4 : 1000;
+            t.deadline = t.period;
+            t.wcet = (i < 3) ? 3 : 1;
+            t.priority = i;
+            tasks->push_back(t);
+        }
+        for (tick_t horizon : {20000, 80000}) {
+            cases.push_back({"multicore/global_backlog/m=2/n=4/h=" + std::to_string(horizon), [=] {
+                GlobalSimulator<PolicyFPP> sim(*tasks, horizon, 2, SimEngine::Event);
+                sim.run(false, false);
+                return Work{static_cast<double>(horizon), total_jobs(sim.metrics())};
+            }});
+        }
+    }
+
+    // --- Breakdown: ricerca binaria con simulazioni terminate al primo miss ---
+    {
+        auto tasks = std::make_shared<std::vector<Task>>(make_taskset(8, 1001));
+        const tick_t horizon = 10000;
+        auto add_breakdown = [&](auto policy) {
+            using P = decltype(policy);
+            cases.push_back({std::string("breakdown/policy=") + P::name + "/n=8/h=10000", [=] {
+                BreakdownConfig bcfg;
+                bcfg.use_rta = false;
+                const BreakdownResult r = breakdown_search<P>(*tasks, horizon, bcfg);
+                return Work{static_cast<double>(horizon) * r.simulations, 0.0};
+            }});
+        };
+        add_breakdown(PolicyFPP{});
+        add_breakdown(PolicyEDF{});
+    }
+
+    // --- Terminazione anticipata: costo delle condizioni e run sovraccarica fermata al primo miss ---
+    {
+        auto tasks = std::make_shared<std::vector<Task>>(make_taskset(8, 1001));
+        auto overloaded = std::make_shared<std::vector<Task>>(scale_wcets(*tasks, 1.5));
+        const tick_t horizon = 100000;
+        auto add_stop = [&](const std::string& name, std::shared_ptr<std::vector<Task>> set, StopConditions stop) {
+            cases.push_back({"stop/" + name + "/n=8/h=100000", [=] {
+                Simulator sim(*set, horizon, SimEngine::Event);
+                sim.set_stop_conditions(stop);
+                sim.run(false, false, false);
+                return Work{static_cast<double>(sim.metrics().stop_tick), total_jobs(sim.metrics())};
+            }});
+        };
+        StopConditions never;
+        never.miss_count = std::int64_t{1} << 40;
+        never.max_backlog = std::int64_t{1} << 40;
+        StopConditions first_miss;
+        first_miss.first_miss = true;
+        add_stop("none", tasks, {});
+        add_stop("unmet", tasks, never);
+        add_stop("overloaded_full", overloaded, {});
+        add_stop("overloaded_first_miss", overloaded, first_miss);
+    }
+
+    // --- Lockstep: 256 task set da 8 task, stesso horizon ---
+    {
+        auto sets = std::make_shared<std::vector<std::vector<Task>>>();
+        for (std::uint32_t seed = 0; seed < 256; ++seed) sets->push_back(make_taskset(8, 5000 + seed));
+        const tick_t horizon = 10000;
+        const double ticks = static_cast<double>(horizon) * static_cast<double>(sets->size());
+
+        cases.push_back({"lockstep/sets=256/n=8/h=10000", [=] {
+            LockstepSimulator<PolicyFPP> sim(*sets, horizon);
+            sim.run();
+            double jobs = 0.0;
+            for (const auto& m : sim.metrics()) jobs += total_jobs(m);
+            return Work{ticks, jobs};
+        }});
+        for (SimEngine engine : {SimEngine::Tick, SimEngine::Event}) {
+            const std::string eng = (engine == SimEngine::Tick) ? "tick" : "event";
+            cases.push_back({"lockstep/per_set_" + eng + "/sets=256/n=8/h=10000", [=] {
+                double jobs = 0.0;
+                for (const auto& tasks : *sets) {
+                    Simulator sim(tasks, horizon, engine);
+                    sim.run(false, false, false);
+                    jobs += total_jobs(sim.metrics());
+                }
+                return Work{ticks, jobs};
+            }});
+        }
+    }
+
+    // --- Generazione e iperperiodo ---
+    for (std::int32_t n_tasks : {8, 64}) {
+        // Seed per caso: n=8 e n=64 generano la stessa sequenza, a prescindere dall'ordine dei casi.
+        cases.push_back({"generate/n=" + std::to_string(n_tasks), [=, seed = std::uint32_t{1}]() mutable {
+            volatile auto size = make_taskset(n_tasks, seed++).size();
+            (void)size;
+            return Work{};
+        }});
+    }
+
+    // Batch SoA con RNG counter-based: 10000 task set da 8 task per operazione.
+    for (UtilizationMode mode : {UtilizationMode::Normalized, UtilizationMode::UUniFast}) {
+        GeneratorConfig gcfg;
+        gcfg.n_tasks = 8;
+        gcfg.Tmin = 10;
+        gcfg.Tmax = 150;
+        gcfg.utilization_target = 0.85;
+        gcfg.utilization_mode = mode;
+        const std::string name = (mode == UtilizationMode::UUniFast) ? "uunifast" : "normalized";
+        // Contatore per caso: la k-esima ripetizione genera sempre i set [10000 k, 10000 (k + 1)).
+        cases.push_back({"generate_batch/" + name + "/n=8/sets=10000", [=, first = std::uint64_t{0}]() mutable {
+            const TaskSetBatch batch = TaskSetGenerator::generate_batch(gcfg, first, 10000);
+            first += 10000;
+            volatile auto size = batch.wcets.size();
+            (void)size;
+            return Work{};
+        }});
+    }
+
+    {
+        auto tasks = std::make_shared<std::vector<Task>>(make_taskset(8, 1001));
+        cases.push_back({"hyperperiod/n=8", [=] {
+            for (int k = 0; k < 1000; ++k) {
+                volatile tick_t hp = hyperperiod(*tasks);
+                (void)hp;
+            }
+            return Work{0.0, 0.0, 1000};
+        }});
+    }
+
+    // --- Export CSV: 100 run da 8 task per operazione ---
+    {
+        auto tasks = std::make_shared<std::vector<Task>>(make_taskset(8, 1001));
+        auto metrics = std::make_shared<SimulationMetrics>();
+        {
+            Simulator sim(*tasks, 10000, SimEngine::Event);
+            sim.run(false, false, false);
+            *metrics = sim.metrics();
+        }
+
+        const std::string summary = (tmp_dir / "bench_summary.csv").string();
+        const std::string per_task = (tmp_dir / "bench_per_task.csv").string();
+
+        cases.push_back({"csv/append_functions/runs=100", [=] {
+            std::filesystem::remove(summary);
+            std::filesystem::remove(per_task);
+            for (std::int64_t run_id = 0; run_id < 100; ++run_id) {
+                append_summary_csv(summary, run_id, *tasks, *metrics, "FPP");
+                append_per_task_csv(per_task, run_id, *tasks, *metrics, "FPP");
+            }
+            return Work{};
+        }});
+        cases.push_back({"csv/exporter/runs=100", [=] {
+            std::filesystem::remove(summary);
+            std::filesystem::remove(per_task);
+            CsvExporter exporter(summary, per_task);
+            for (std::int64_t run_id = 0; run_id < 100; ++run_id) {
+                exporter.write_run(run_id, *tasks, *metrics, "FPP");
+            }
+            exporter.close();
+            return Work{};
+        }});
+    }
+
+    return cases;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string filter = (argc > 1) ? argv[1] : "";
+
+    const std::filesystem::path tmp_dir = std::filesystem::temp_directory_path() / "rt_bench_suite";
+    std::filesystem::create_directories(tmp_dir);
+
+    std::cout << std::left << std::setw(40) << "benchmark"
+              << std::right << std::setw(10) << "runs"
+              << std::setw(16) << "ns/op"
+              << std::setw(16) << "Mticks/s"
+              << std::setw(16) << "Mjobs/s"
+              << "\n";
+    std::cout << std::string(40 + 10 + 16 + 16 + 16, '-') << "\n";
+
+    for (const auto& bc : build_cases(tmp_dir)) {
+        if (!filter.empty() && bc.name.find(filter) == std::string::npos) continue;
+        run_case(bc);
+    }
+
+    std::filesystem::remove_all(tmp_dir);
+    return 0;
+}
@@ -0,0 +1,306 @@
+// aggregates.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Statistiche aggregate sulle run di un batch, calcolate in streaming (senza rileggere i CSV):
+// - RunningStats: media/varianza di Welford, min/max, merge di Chan (accumulatori parziali)
+// - BatchAggregator: gruppi per chiavi configurabili (politica, bucket di utilizzazione,
+//   numero di task) con frazione di run schedulabili, utilizzazione, miss ratio, lateness
+// Report finale compatto: tabella su console e CSV (una riga per gruppo, ordine stabile).
+// Lo stato degli accumulatori è salvabile per riprendere una campagna interrotta
+// (double come bit pattern: ripresa esatta, vedi batch_journal.hpp).
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <map>
+#include <tuple>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <bit>
+
+#include "task.hpp"
+#include "metrics.hpp"
+#include "scheduler.hpp"
+#include "csv_export.hpp"
+
+namespace rt {
+
+// Media e varianza online (Welford); merge con la formula di Chan et al.
+struct RunningStats {
+    std::int64_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+
+    void add(double x) {
+        count++;
+        const double delta = x - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (x - mean);
+        min = std::min(min, x);
+        max = std::max(max, x);
+    }
+
+    void merge(const RunningStats& o) {
+        if (o.count == 0) return;
+        if (count == 0) {
+            *this = o;
+            return;
+        }
+        const double n = static_cast<double>(count + o.count);
+        const double delta = o.mean - mean;
+        mean += delta * static_cast<double>(o.count) / n;
+        m2 += o.m2 + delta * delta * static_cast<double>(count) * static_cast<double>(o.count) / n;
+        count += o.count;
+        min = std::min(min, o.min);
+        max = std::max(max, o.max);
+    }
+
+    // Varianza campionaria (0 con meno di due valori).
+    double variance() const {
+        return count > 1 ? m2 / static_cast<double>(count - 1) : 0.0;
+    }
+
+    double stddev() const { return std::sqrt(variance()); }
+
+    void save(std::ostream& os) const {
+        os << count << ' ' << std::bit_cast<std::uint64_t>(mean) << ' ' << std::bit_cast<std::uint64_t>(m2)
+           << ' ' << std::bit_cast<std::uint64_t>(min) << ' ' << std::bit_cast<std::uint64_t>(max);
+    }
+
+    void load(std::istream& is) {
+        std::uint64_t bits[4] = {};
+        is >> count >> bits[0] >> bits[1] >> bits[2] >> bits[3];
+        mean = std::bit_cast<double>(bits[0]);
+        m2 = std::bit_cast<double>(bits[1]);
+        min = std::bit_cast<double>(bits[2]);
+        max = std::bit_cast<double>(bits[3]);
+    }
+};
+
+// Chiavi di raggruppamento del report aggregato.
+enum class AggregateKey {
+    Policy,             // politica di scheduling
+    UtilizationBucket,  // utilizzazione del task set (somma C/T) a bucket di larghezza fissa
+    NTasks              // numero di task
+};
+
+// Le statistiche misurate coprono solo le run simulate: una run scartata dalla RTA
+// (StopReason::RtaUnschedulable) conta in runs come non schedulabile e basta.
+struct AggregateGroup {
+    std::int64_t runs = 0;
+    std::int64_t schedulable = 0;   // run senza deadline miss nell'horizon
+    RunningStats utilization;       // utilizzazione CPU misurata (busy / horizon)
+    RunningStats miss_ratio;        // deadline miss / job completati
+    RunningStats lateness_max;      // lateness massima tra i task della run
+
+    void add(const SimulationMetrics& m) {
+        if (m.stop_reason == StopReason::RtaUnschedulable) {
+            add_unschedulable();
+            return;
+        }
+
+        std::int64_t completed = 0;
+        tick_t late_max = 0;
+        for (const auto& tm : m.per_task) {
+            completed += tm.jobs_completed;
+            late_max = std::max(late_max, tm.lateness_max);
+        }
+
+        runs++;
+        if (!m.missed_deadline()) schedulable++;
+        utilization.add(m.utilization());
+        miss_ratio.add(completed > 0
+            ? static_cast<double>(m.deadline_miss_total) / static_cast<double>(completed) : 0.0);
+        lateness_max.add(static_cast<double>(late_max));
+    }
+
+    // Run non simulata ma dimostrata non schedulabile (nessuna metrica misurata).
+    void add_unschedulable() { runs++; }
+
+    void merge(const AggregateGroup& o) {
+        runs += o.runs;
+        schedulable += o.schedulable;
+        utilization.merge(o.utilization);
+        miss_ratio.merge(o.miss_ratio);
+        lateness_max.merge(o.lateness_max);
+    }
+
+    double schedulable_ratio() const {
+        return runs > 0 ? static_cast<double>(schedulable) / static_cast<double>(runs) : 0.0;
+    }
+
+    void save(std::ostream& os) const {
+        os << runs << ' ' << schedulable << ' ';
+        utilization.save(os);
+        os << ' ';
+        miss_ratio.save(os);
+        os << ' ';
+        lateness_max.save(os);
+    }
+
+    void load(std::istream& is) {
+        is >> runs >> schedulable;
+        utilization.load(is);
+        miss_ratio.load(is);
+        lateness_max.load(is);
+    }
+};
+
+inline const char* aggregate_csv_header() {
+    return "policy,u_bucket,n_tasks,runs,schedulable,schedulable_ratio,"
+           "util_mean,util_std,util_min,util_max,miss_ratio_mean,miss_ratio_std,miss_ratio_max,"
+           "late_max_mean,late_max_max";
+}
+
+class BatchAggregator {
+public:
+    BatchAggregator(std::vector<AggregateKey> keys, double utilization_bucket_width)
+        : keys_(std::move(keys)), bucket_width_(utilization_bucket_width)
+    {
+        if (!(bucket_width_ > 0.0)) {
+            throw std::invalid_argument("BatchAggregator: utilization bucket width must be > 0");
+        }
+    }
+
+    void add(SchedPolicy policy, const std::vector<Task>& tasks, const SimulationMetrics& m) {
+        groups_[key_of(policy, tasks)].add(m);
+    }
+
+    // Fonde un aggregatore parziale con le stesse chiavi (es. per thread o per shard).
+    void merge(const BatchAggregator& o) {
+        for (const auto& [key, group] : o.groups_) groups_[key].merge(group);
+    }
+
+    bool empty() const { return groups_.empty(); }
+
+    // Stato dei gruppi (le chiavi di raggruppamento restano quelle del costruttore).
+    void save(std::ostream& os) const {
+        os << groups_.size();
+        for (const auto& [key, g] : groups_) {
+            os << ' ' << std::get<0>(key) << ' ' << std::get<1>(key) << ' ' << std::get<2>(key) << ' ';
+            g.save(os);
+        }
+    }
+
+    void load(std::istream& is) {
+        std::size_t n = 0;
+        is >> n;
+        groups_.clear();
+        for (std::size_t i = 0; i < n && is; ++i) {
+            GroupKey key;
+            is >> std::get<0>(key) >> std::get<1>(key) >> std::get<2>(key);
+            groups_[key].load(is);
+        }
+        if (!is) throw std::runtime_error("BatchAggregator: invalid saved state");
+    }
+
+    void write_csv(std::string& out) const {
+        for (const auto& [key, g] : groups_) {
+            const auto& [policy, bucket, n_tasks] = key;
+            if (policy >= 0) out.append(policy_name(static_cast<SchedPolicy>(policy)));
+            else out.push_back('*');
+            out.push_back(',');
+            if (bucket >= 0) append_fixed6(out, static_cast<double>(bucket) * bucket_width_);
+            else out.push_back('*');
+            out.push_back(',');
+            if (n_tasks >= 0) append_int(out, n_tasks);
+            else out.push_back('*');
+            out.push_back(',');
+
+            append_int(out, g.runs);                   out.push_back(',');
+            append_int(out, g.schedulable);            out.push_back(',');
+            append_fixed6(out, g.schedulable_ratio()); out.push_back(',');
+            append_fixed6(out, g.utilization.mean);    out.push_back(',');
+            append_fixed6(out, g.utilization.stddev()); out.push_back(',');
+            append_fixed6(out, finite_or_zero(g.utilization.min)); out.push_back(',');
+            append_fixed6(out, finite_or_zero(g.utilization.max)); out.push_back(',');
+            append_fixed6(out, g.miss_ratio.mean);     out.push_back(',');
+            append_fixed6(out, g.miss_ratio.stddev()); out.push_back(',');
+            append_fixed6(out, finite_or_zero(g.miss_ratio.max)); out.push_back(',');
+            append_fixed6(out, g.lateness_max.mean);   out.push_back(',');
+            append_fixed6(out, finite_or_zero(g.lateness_max.max));
+            out.push_back('\n');
+        }
+    }
+
+    void print_report(std::ostream& os) const {
+        os << "\n=== Aggregate results ===\n";
+        os << std::left
+           << std::setw(8)  << "Policy"
+           << std::setw(10) << "U_bucket"
+           << std::setw(8)  << "Tasks"
+           << std::setw(10) << "Runs"
+           << std::setw(10) << "Sched%"
+           << std::setw(18) << "Util (mean+-std)"
+           << std::setw(12) << "Miss_ratio"
+           << std::setw(10) << "Late_max"
+           << "\n";
+        os << std::string(8+10+8+10+10+18+12+10, '-') << "\n";
+
+        for (const auto& [key, g] : groups_) {
+            const auto& [policy, bucket, n_tasks] = key;
+            std::ostringstream util;
+            util << std::fixed << std::setprecision(3) << g.utilization.mean
+                 << "+-" << g.utilization.stddev();
+
+            os << std::left
+               << std::setw(8)  << (policy >= 0 ? policy_name(static_cast<SchedPolicy>(policy)) : "*")
+               << std::setw(10) << (bucket >= 0 ? format_bucket(bucket) : std::string("*"))
+               << std::setw(8)  << (n_tasks >= 0 ? std::to_string(n_tasks) : std::string("*"))
+               << std::setw(10) << g.runs
+               << std::setw(10) << std::fixed << std::setprecision(1) << 100.0 * g.schedulable_ratio()
+               << std::setw(18) << util.str()
+               << std::setw(12) << std::fixed << std::setprecision(6) << g.miss_ratio.mean
+               << std::setw(10) << std::fixed << std::setprecision(0) << finite_or_zero(g.lateness_max.max)
+               << "\n";
+        }
+    }
+
+private:
+    // (politica, bucket, numero task); -1 = chiave non usata per il raggruppamento.
+    using GroupKey = std::tuple<int, std::int64_t, std::int64_t>;
+
+    GroupKey key_of(SchedPolicy policy, const std::vector<Task>& tasks) const {
+        GroupKey key{-1, -1, -1};
+        for (AggregateKey k : keys_) {
+            switch (k) {
+                case AggregateKey::Policy:
+                    std::get<0>(key) = static_cast<int>(policy);
+                    break;
+                case AggregateKey::UtilizationBucket:
+                    std::get<1>(key) = static_cast<std::int64_t>(
+                        std::floor(total_utilization(tasks) / bucket_width_ + 1e-9));
+                    break;
+                case AggregateKey::NTasks:
+                    std::get<2>(key) = static_cast<std::int64_t>(tasks.size());
+                    break;
+            }
+        }
+        return key;
+    }
+
+    // min/max di un gruppo senza run simulate (solo run scartate dalla RTA).
+    static double finite_or_zero(double v) { return std::isfinite(v) ? v : 0.0; }
+
+    std::string format_bucket(std::int64_t bucket) const {
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(2) << static_cast<double>(bucket) * bucket_width_;
+        return os.str();
+    }
+
+    std::vector<AggregateKey> keys_;
+    double bucket_width_;
+    std::map<GroupKey, AggregateGroup> groups_;
+};
+
+} // namespace rt
@@ -0,0 +1,188 @@
+// batch_journal.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Journal di checkpoint per campagne batch lunghe (BatchConfig::checkpoint), scritto
+// accanto ai CSV: un file di testo in sola aggiunta con una riga di commit per ogni
+// gruppo di run esportate.
+// - header: identificativo della campagna (numero di run, politiche, file tracciati);
+//   riprendere una campagna diversa con lo stesso journal è un errore
+// - commit: run completate (sempre un prefisso 0..n-1, esportate in ordine di run_id) e
+//   dimensione in byte di ogni file di output dopo le loro righe
+// - stato degli accumulatori del commit (distribuzioni, aggregati) in "<journal>.state"
+// Protocollo di commit: output consegnati al sistema operativo -> stato in
+// "<journal>.state.tmp" -> riga di commit -> rename dello stato. Un'interruzione in
+// qualsiasi punto lascia valido l'ultimo commit completo, con il suo stato in .state o
+// ancora in .tmp. Alla ripresa i file di output vengono troncati alle dimensioni
+// dell'ultimo commit (nessuna riga parziale o duplicata) e le run già registrate non
+// vengono rieseguite.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+namespace rt {
+
+class BatchJournal {
+public:
+    struct Commit {
+        std::int64_t runs_done = 0;
+        bool finished = false;                  // file di fine campagna già scritti
+        std::vector<std::uint64_t> offsets;     // dimensione di ogni file tracciato
+    };
+
+    // Apre il journal `path` della campagna `campaign`, che accoda righe a `outputs`.
+    // Journal nuovo: primo commit con le dimensioni attuali dei file (le righe già
+    // presenti restano). Journal esistente: riparte dal suo ultimo commit completo.
+    BatchJournal(std::string path, std::string campaign, std::vector<std::string> outputs)
+        : path_(std::move(path)), outputs_(std::move(outputs))
+    {
+        const std::string header = "rt-journal 1 " + campaign;
+
+        if (std::filesystem::exists(path_) && parse(header)) {
+            resumed_ = true;
+            out_.open(path_, std::ios::binary | std::ios::app);
+            if (!out_) throw std::runtime_error("Cannot open batch journal: " + path_);
+            return;
+        }
+
+        // Nessun commit: la campagna non ha ancora scritto nulla, si riparte da zero.
+        std::filesystem::remove(state_path());
+        std::filesystem::remove(state_tmp_path());
+        out_.open(path_, std::ios::binary | std::ios::trunc);
+        if (!out_) throw std::runtime_error("Cannot create batch journal: " + path_);
+        out_ << header << '\n';
+
+        Commit first;
+        for (const auto& p : outputs_) {
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(p, ec);
+            first.offsets.push_back(ec ? 0 : size);
+        }
+        append(first);
+    }
+
+    bool resumed() const { return resumed_; }
+    const Commit& last() const { return last_; }
+
+    // Riporta i file di output all'ultimo commit (prima di riaprirli in append).
+    void rollback_outputs() const {
+        for (size_t i = 0; i < outputs_.size(); ++i) {
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(outputs_[i], ec);
+            const std::uint64_t current = ec ? 0 : size;
+            if (current < last_.offsets[i]) {
+                throw std::runtime_error("Output file shorter than its journal commit: " + outputs_[i]);
+            }
+            if (current > last_.offsets[i]) std::filesystem::resize_file(outputs_[i], last_.offsets[i]);
+        }
+    }
+
+    // Stato salvato con l'ultimo commit (vuoto se nessuno è stato salvato).
+    std::string load_state() const {
+        for (const std::string& p : {state_path(), state_tmp_path()}) {
+            std::ifstream in(p, std::ios::binary);
+            if (!in) continue;
+            std::int64_t runs = -1;
+            in >> runs;
+            in.get();
+            if (runs != last_.runs_done) continue;
+            return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        }
+        if (std::filesystem::exists(state_path())) {
+            throw std::runtime_error("Batch journal state does not match its last commit: " + state_path());
+        }
+        return {};
+    }
+
+    // Registra un commit: gli output devono essere già stati scritti fino a `c.offsets`.
+    void commit(Commit c, const std::string& state) {
+        if (c.offsets.size() != outputs_.size()) {
+            throw std::logic_error("BatchJournal: commit with wrong number of offsets");
+        }
+        if (!state.empty()) {
+            std::ofstream s(state_tmp_path(), std::ios::binary | std::ios::trunc);
+            s << c.runs_done << '\n' << state;
+            s.close();
+            if (s.fail()) throw std::runtime_error("Error writing batch journal state: " + state_tmp_path());
+        }
+        append(c);
+        if (!state.empty()) std::filesystem::rename(state_tmp_path(), state_path());
+    }
+
+    // Campagna completata: journal e stato non servono più.
+    void remove() {
+        out_.close();
+        std::filesystem::remove(path_);
+        std::filesystem::remove(state_path());
+        std::filesystem::remove(state_tmp_path());
+    }
+
+private:
+    std::string state_path() const { return path_ + ".state"; }
+    std::string state_tmp_path() const { return path_ + ".state.tmp"; }
+
+    void append(Commit c) {
+        out_ << "commit " << c.runs_done << ' ' << (c.finished ? 1 : 0) << ' ' << c.offsets.size();
+        for (std::uint64_t o : c.offsets) out_ << ' ' << o;
+        out_ << '\n';
+        out_.flush();
+        if (!out_) throw std::runtime_error("Error writing batch journal: " + path_);
+        last_ = std::move(c);
+    }
+
+    // Ultimo commit completo (falso se non ce n'è nessuno); una riga finale troncata
+    // viene rimossa dal file.
+    bool parse(const std::string& header) {
+        std::ifstream in(path_, std::ios::binary);
+        const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        std::size_t pos = text.find('\n');
+        if (pos == std::string::npos) return false;
+        if (text.compare(0, pos, header) != 0) {
+            throw std::runtime_error("Batch journal belongs to a different campaign: " + path_);
+        }
+
+        bool found = false;
+        std::size_t valid_end = pos + 1;
+        for (std::size_t begin = pos + 1; begin < text.size(); ) {
+            const std::size_t end = text.find('\n', begin);
+            if (end == std::string::npos) break;
+
+            std::istringstream line(text.substr(begin, end - begin));
+            std::string tag;
+            Commit c;
+            int finished = 0;
+            std::size_t n = 0;
+            line >> tag >> c.runs_done >> finished >> n;
+            if (!line || tag != "commit" || n != outputs_.size()) {
+                throw std::runtime_error("Corrupted batch journal: " + path_);
+            }
+            c.finished = finished != 0;
+            c.offsets.resize(n);
+            for (auto& o : c.offsets) line >> o;
+            if (!line) throw std::runtime_error("Corrupted batch journal: " + path_);
+
+            last_ = std::move(c);
+            found = true;
+            begin = valid_end = end + 1;
+        }
+        if (found && valid_end < text.size()) std::filesystem::resize_file(path_, valid_end);
+        return found;
+    }
+
+    std::string path_;
+    std::vector<std::string> outputs_;
+    std::ofstream out_;
+    bool resumed_ = false;
+    Commit last_;
+};
+
+} // namespace rt
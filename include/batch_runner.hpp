@@ -1,9 +1,30 @@
 // batch_runner.hpp
 // Created by Francesco on 17/02/2026.
 //
-// Esecuzione batch (sequenziale) di più task set.
+// Esecuzione batch di più task set, sequenziale o parallela (work stealing).
 // Supporta horizon fisso o iperperiodo, limite massimo all'horizon,
 // export CSV e progresso sintetico con stima ETA.
+// Ogni task set può essere simulato con più politiche (BatchConfig::policies):
+// una riga per politica, con la colonna `policy` valorizzata di conseguenza.
+// In modalità parallela le righe CSV sono comunque scritte in ordine di run_id.
+// run_stream: pipeline generazione -> simulazione -> export senza materializzare
+// tutti i task set, con un numero limitato di run in volo.
+// Gli istogrammi per task (quantili del per_task) sono raccolti solo con
+// BatchConfig::collect_histograms o export_distributions.
+// Opzionalmente gli istogrammi per task vengono fusi per politica su tutta la campagna
+// (BatchConfig::export_distributions) e riassunti in quantili a fine batch.
+// Statistiche aggregate in streaming (BatchConfig::export_aggregates, aggregates.hpp):
+// aggiornate dal thread che esporta, quindi in ordine di run_id e senza lock nei worker.
+// Con BatchConfig::cores > 1 ogni politica è simulata su più core (multiprocessor.hpp).
+// Con BatchConfig::breakdown_search ogni riga del summary riporta anche il fattore di
+// scala critico dei WCET (sensitivity.hpp).
+// Con BatchConfig::stop le run terminano alla prima condizione soddisfatta (primo miss,
+// N miss, miss di un task, backlog): colonne stop_tick e stop_reason del summary.
+// Con BatchConfig::lockstep le run senza output per run vengono simulate a blocchi di
+// lockstep_block_runs task set con LockstepSimulator, dove conviene (stesse metriche).
+// Con BatchConfig::checkpoint un journal accanto ai CSV registra le run esportate
+// (batch_journal.hpp): una campagna interrotta e rilanciata riprende dalla prima run
+// non registrata, accodando ai file esistenti.
 
 #pragma once
 
@@ -16,11 +37,27 @@
 #include <sstream>
 #include <algorithm>
 #include <stdexcept>
+#include <optional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <exception>
+#include <filesystem>
+#include <utility>
+#include <type_traits>
 
 #include "task.hpp"
 #include "simulator.hpp"
+#include "lockstep_simulator.hpp"
+#include "multiprocessor.hpp"
+#include "sensitivity.hpp"
 #include "time_utils.hpp"
 #include "csv_export.hpp"
+#include "binary_export.hpp"
+#include "thread_pool.hpp"
+#include "rta.hpp"
+#include "aggregates.hpp"
+#include "batch_journal.hpp"
 
 namespace rt {
 
@@ -29,6 +66,32 @@ enum class HorizonMode {
     Hyperperiod
 };
 
+// Formato dei risultati: i file binari colonnari hanno lo stesso percorso dei CSV
+// con estensione ".rtcol" (vedi binary_export.hpp, convertibili con binary_to_csv).
+enum class OutputFormat {
+    Csv,
+    Binary,
+    CsvAndBinary
+};
+
+// Uso della Response-Time Analysis nel batch (vedi rta.hpp). Con modalità diverse da Off
+// i WCRT vengono esportati in un CSV dedicato (BatchConfig::rta_csv_path).
+// L'analisi è per FPP uniprocessore: Prefilter e CrossCheck riguardano solo la simulazione
+// FPP e sono ignorati con BatchConfig::cores > 1.
+// - Prefilter:  i task set dimostrati non schedulabili da un'analisi esatta non vengono simulati;
+//               la loro riga FPP resta nel summary (metriche nulle, stop_tick 0,
+//               stop_reason "rta_unschedulable"), così le frazioni di schedulabilità
+//               calcolate dal summary contano anche le run scartate
+// - Replace:    solo RTA, nessuna simulazione (nessuna riga in summary/per-task,
+//               incompatibile con BatchConfig::export_aggregates)
+// - CrossCheck: simulazione + RTA, errore se un rt_max simulato supera il bound RTA
+enum class RtaMode {
+    Off,
+    Prefilter,
+    Replace,
+    CrossCheck
+};
+
 struct BatchConfig {
     HorizonMode horizon_mode = HorizonMode::Fixed;
     tick_t fixed_horizon = 1000;
@@ -36,6 +99,51 @@ struct BatchConfig {
     // 0 = nessun limite; se > 0 limita l'horizon massimo
     tick_t max_horizon = 0;
 
+    // Motore di simulazione (Event produce le stesse metriche di Tick, ma salta i tick inattivi)
+    SimEngine engine = SimEngine::Tick;
+
+    // Politiche con cui simulare ogni task set, nell'ordine in cui compaiono nei CSV.
+    std::vector<SchedPolicy> policies = {SchedPolicy::FPP};
+
+    // Rilevamento dello stato stazionario (vedi simulator.hpp): i cicli di iperperiodo
+    // identici non vengono simulati ma estrapolati (colonna extrapolated_ticks).
+    // Lo stato si ripete solo a multipli dell'iperperiodo: utile quando l'horizon ne
+    // contiene più d'uno (es. horizon fisso lungo), senza effetto se horizon <= O_max + 2H.
+    bool steady_state = false;
+
+    // Overhead di context switch in tick (vedi BasicSimulator::set_switch_overhead):
+    // tempo CPU speso prima che il job selezionato esegua, a ogni cambio di job.
+    tick_t switch_overhead = 0;
+
+    // Istogrammi per task: colonne rt_p50..start_p99 del per_task (-1 se disattivati).
+    // Costano ~15-20% del motore a eventi; sempre attivi con export_distributions.
+    bool collect_histograms = false;
+
+    // Task set piccoli (al più lockstep_max_tasks task) simulati a blocchi con
+    // LockstepSimulator, con FPP, DM ed EDF: stesse metriche, più veloce sui target con
+    // lane vettoriali larghe (AVX2/AVX-512, opzione CMake RT_NATIVE_ARCH). Ignorato con
+    // opzioni che il lockstep non supporta (core > 1, stato stazionario, overhead di
+    // switch, stop, breakdown, istogrammi) o con output per run su console.
+    bool lockstep = true;
+
+    // Numero di core identici (1 = uniprocessore). Con più core: scheduling globale
+    // (solo FPP e DM, senza overhead di switch) o partizionato (tutte le politiche, task
+    // assegnati con partition_heuristic). La timeline di debug non è disponibile.
+    std::size_t cores = 1;
+    MpScheduling mp_scheduling = MpScheduling::Global;
+    PartitionHeuristic partition_heuristic = PartitionHeuristic::FirstFit;
+
+    // Breakdown dei WCET per ogni politica (solo uniprocessore): ricerca binaria del
+    // fattore di scala critico con RTA o simulazioni terminate al primo miss
+    // (colonne critical_scaling e breakdown_utilization del summary, -1 se disabilitato).
+    bool breakdown_search = false;
+    double breakdown_tolerance = 1e-3;
+
+    // Terminazione anticipata delle run (vedi StopConditions in simulator.hpp, solo
+    // uniprocessore): utile negli sweep di schedulabilità, dove conta solo se e quando
+    // la run fallisce. Le metriche della riga coprono [0, stop_tick).
+    StopConditions stop;
+
     bool debug_timeline = false;
     bool print_input_each_run = false;
     bool print_summary_each_run = false;
@@ -43,6 +151,348 @@ struct BatchConfig {
 
     // Stampa il progresso ogni N run completate
     std::size_t progress_every_runs = 1;
+
+    // Numero di worker: 1 = sequenziale, 0 = std::thread::hardware_concurrency().
+    // Con output per-run su console (timeline/input/summary) si resta sequenziali
+    // per non mescolare le stampe.
+    std::size_t workers = 1;
+
+    // Scritture CSV su un thread dedicato (i file restano comunque aperti per tutto il batch)
+    bool background_writer = false;
+
+    // Solo run_stream: massimo numero di run in volo (generate/simulate ma non ancora
+    // esportate). 0 = 4 * workers (in blocchi di run se il lockstep è attivo); mai meno
+    // di un blocco.
+    std::size_t max_in_flight = 0;
+
+    OutputFormat output_format = OutputFormat::Csv;
+
+    RtaMode rta_mode = RtaMode::Off;
+
+    // Vuoto = "rta.csv" nella stessa directory del summary.
+    std::string rta_csv_path;
+
+    // Distribuzioni aggregate per politica: istogrammi di tutti i task di tutte le run,
+    // fusi in ordine di run_id (stesso risultato con qualsiasi numero di worker).
+    // Una riga per politica, scritta alla chiusura del batch.
+    bool export_distributions = false;
+
+    // Vuoto = "distributions.csv" nella stessa directory del summary.
+    std::string distributions_csv_path;
+
+    // Aggregati per gruppo (frazione schedulabile, utilizzazione, miss ratio, lateness)
+    // calcolati run per run: report su console a fine batch (con print_progress) e CSV.
+    bool export_aggregates = false;
+    std::vector<AggregateKey> aggregate_keys = {AggregateKey::Policy};
+
+    // Larghezza dei bucket di AggregateKey::UtilizationBucket (somma C/T).
+    double utilization_bucket_width = 0.1;
+
+    // Vuoto = "aggregates.csv" nella stessa directory del summary.
+    std::string aggregates_csv_path;
+
+    // Checkpoint della campagna (solo OutputFormat::Csv): le run esportate vengono
+    // registrate nel journal a gruppi, al più ogni checkpoint_interval_seconds (0 = dopo
+    // ogni run). Se il journal esiste la campagna riprende dall'ultimo commit; a campagna
+    // completata il journal viene rimosso. Vuoto = "<summary>.journal".
+    // Il journal registra la configurazione che determina i risultati (horizon, motore,
+    // politiche, core, stop, RTA, output...) e campaign_fingerprint: riprendere con valori
+    // diversi è un errore invece di accodare righe incoerenti.
+    bool checkpoint = false;
+    double checkpoint_interval_seconds = 10.0;
+    std::string journal_path;
+
+    // Identità dei task set della campagna fornita dal chiamante, su una riga
+    // (es. SeedRangeSource::describe()). Con run() si aggiunge un hash dei task set.
+    std::string campaign_fingerprint;
+
+    // Valore aggiunto ai run_id esportati: la run i del batch compare come run_id_offset + i
+    // (shard di una campagna con run_id globali, vedi campaign.hpp).
+    std::int64_t run_id_offset = 0;
+};
+
+// Istogrammi per task nelle run del batch: richiesti o necessari alle distribuzioni.
+inline bool histograms_enabled(const BatchConfig& cfg) {
+    return cfg.collect_histograms || cfg.export_distributions;
+}
+
+// Destinazioni dei risultati di un batch (CSV e/o binario colonnare).
+class ResultsExporter {
+public:
+    ResultsExporter(const std::string& summary_csv_path,
+                    const std::string& per_task_csv_path,
+                    const BatchConfig& cfg,
+                    std::int64_t runs_total,
+                    const std::string& tasksets_id = {}) {
+        run_id_offset_ = cfg.run_id_offset;
+        if (cfg.checkpoint) open_journal(summary_csv_path, per_task_csv_path, cfg, runs_total, tasksets_id);
+
+        if (cfg.output_format != OutputFormat::Binary) {
+            csv_.emplace(summary_csv_path, per_task_csv_path, cfg.background_writer);
+        }
+        if (cfg.output_format != OutputFormat::Csv) {
+            binary_.emplace(binary_path_for(summary_csv_path), binary_path_for(per_task_csv_path));
+        }
+        if (cfg.rta_mode != RtaMode::Off) {
+            const std::string path = cfg.rta_csv_path.empty()
+                ? std::filesystem::path(summary_csv_path).replace_filename("rta.csv").string()
+                : cfg.rta_csv_path;
+            rta_.emplace(path, cfg.background_writer);
+            if (rta_->was_empty()) rta_->buffer().append(rta_csv_header()).push_back('\n');
+        }
+        if (cfg.export_distributions) {
+            distributions_path_ = cfg.distributions_csv_path.empty()
+                ? std::filesystem::path(summary_csv_path).replace_filename("distributions.csv").string()
+                : cfg.distributions_csv_path;
+            for (SchedPolicy policy : cfg.policies) distributions_.push_back({policy, {}});
+        }
+        if (cfg.export_aggregates) {
+            if (cfg.rta_mode == RtaMode::Replace) {
+                throw std::invalid_argument("BatchRunner: aggregates require simulated runs, not RtaMode::Replace");
+            }
+            aggregates_path_ = cfg.aggregates_csv_path.empty()
+                ? std::filesystem::path(summary_csv_path).replace_filename("aggregates.csv").string()
+                : cfg.aggregates_csv_path;
+            aggregates_.emplace(cfg.aggregate_keys, cfg.utilization_bucket_width);
+        }
+
+        if (journal_ && journal_->resumed()) restore_state();
+        last_commit_ = std::chrono::steady_clock::now();
+    }
+
+    static std::string binary_path_for(const std::string& csv_path) {
+        return std::filesystem::path(csv_path).replace_extension(".rtcol").string();
+    }
+
+    void write_run(std::int64_t run_id,
+                   const std::vector<Task>& tasks,
+                   const SimulationMetrics& m,
+                   const std::string& policy) {
+        if (csv_) csv_->write_run(run_id_offset_ + run_id, tasks, m, policy);
+        if (binary_) binary_->write_run(run_id_offset_ + run_id, tasks, m, policy);
+    }
+
+    void write_rta(std::int64_t run_id, const std::vector<Task>& tasks, const RtaResult& rta) {
+        if (!rta_) return;
+        std::string& out = rta_->buffer();
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            const auto& t = tasks[i];
+            append_int(out, run_id_offset_ + run_id); out.push_back(',');
+            append_int(out, static_cast<std::uint64_t>(i)); out.push_back(',');
+            append_int(out, t.id);         out.push_back(',');
+            append_int(out, t.priority);   out.push_back(',');
+            append_int(out, t.period);     out.push_back(',');
+            append_int(out, t.deadline);   out.push_back(',');
+            append_int(out, t.wcet);       out.push_back(',');
+            append_int(out, rta.wcrt[i]);  out.push_back(',');
+            out.push_back(rta.wcrt[i] != no_tick ? '1' : '0');
+            out.push_back('\n');
+        }
+        rta_->maybe_flush();
+    }
+
+    // Aggiorna distribuzioni e aggregati con una simulazione (chiamata in ordine di run_id).
+    void accumulate(SchedPolicy policy, const std::vector<Task>& tasks, const SimulationMetrics& m) {
+        if (aggregates_) aggregates_->add(policy, tasks, m);
+        if (m.stop_reason == StopReason::RtaUnschedulable) return;   // nessun job simulato
+        for (auto& [p, agg] : distributions_) {
+            if (p != policy) continue;
+            for (const auto& tm : m.per_task) agg.merge(tm);
+            return;
+        }
+    }
+
+    const std::optional<BatchAggregator>& aggregates() const { return aggregates_; }
+
+    // Prima run da eseguire: 0, o la prima non registrata nel journal di una ripresa.
+    std::int64_t first_run() const { return journal_ ? journal_->last().runs_done : 0; }
+
+    // Da chiamare dopo l'export di `run_id` (in ordine): commit nel journal se è passato
+    // l'intervallo di checkpoint. Costo trascurabile tra un commit e l'altro.
+    void end_run(std::int64_t run_id) {
+        if (!journal_) return;
+        const auto now = std::chrono::steady_clock::now();
+        if (std::chrono::duration<double>(now - last_commit_).count() < checkpoint_interval_) return;
+        commit(run_id + 1, false);
+        last_commit_ = now;
+    }
+
+    void close() {
+        // Campagna già completata da un'esecuzione precedente: nulla da riscrivere.
+        const bool finished = journal_ && journal_->last().finished;
+        if (journal_ && !finished) commit(runs_total_, false);
+
+        if (csv_) csv_->close();
+        if (binary_) binary_->close();
+        if (rta_) rta_->close();
+        if (!finished && distributions_path_) dist_offset_ = write_distributions(*distributions_path_);
+        if (!finished && aggregates_path_) agg_offset_ = write_aggregates(*aggregates_path_);
+
+        if (journal_) {
+            if (!finished) commit(runs_total_, true);
+            journal_->remove();
+        }
+    }
+
+private:
+    // Campagna identificata da numero di run, configurazione, file tracciati e impronta
+    // dei task set: i file di output vengono riportati all'ultimo commit prima di riaprirli.
+    void open_journal(const std::string& summary_csv_path,
+                      const std::string& per_task_csv_path,
+                      const BatchConfig& cfg,
+                      std::int64_t runs_total,
+                      const std::string& tasksets_id) {
+        if (cfg.output_format != OutputFormat::Csv) {
+            throw std::invalid_argument("BatchRunner: checkpoint requires OutputFormat::Csv");
+        }
+        if (cfg.campaign_fingerprint.find('\n') != std::string::npos) {
+            throw std::invalid_argument("BatchRunner: campaign fingerprint must be a single line");
+        }
+        runs_total_ = runs_total;
+        checkpoint_interval_ = cfg.checkpoint_interval_seconds;
+
+        const auto beside = [&](const std::string& configured, const char* name) {
+            return configured.empty()
+                ? std::filesystem::path(summary_csv_path).replace_filename(name).string()
+                : configured;
+        };
+        std::vector<std::string> outputs = {summary_csv_path, per_task_csv_path};
+        if (cfg.rta_mode != RtaMode::Off) outputs.push_back(beside(cfg.rta_csv_path, "rta.csv"));
+        if (cfg.export_distributions) outputs.push_back(beside(cfg.distributions_csv_path, "distributions.csv"));
+        if (cfg.export_aggregates) outputs.push_back(beside(cfg.aggregates_csv_path, "aggregates.csv"));
+
+        std::ostringstream id;
+        id << std::setprecision(17)
+           << "runs=" << runs_total << " first_run_id=" << cfg.run_id_offset << " policies=";
+        for (size_t i = 0; i < cfg.policies.size(); ++i) {
+            id << (i > 0 ? "," : "") << policy_name(cfg.policies[i]);
+        }
+        id << " horizon=" << (cfg.horizon_mode == HorizonMode::Fixed ? "fixed:" : "hyperperiod:")
+           << cfg.fixed_horizon << " max_horizon=" << cfg.max_horizon
+           << " engine=" << (cfg.engine == SimEngine::Tick ? "tick" : "event")
+           << " steady_state=" << cfg.steady_state << " switch_overhead=" << cfg.switch_overhead
+           << " histograms=" << histograms_enabled(cfg)
+           << " cores=" << cfg.cores << ':' << static_cast<int>(cfg.mp_scheduling) << ':'
+           << static_cast<int>(cfg.partition_heuristic)
+           << " breakdown=" << cfg.breakdown_search << ':' << cfg.breakdown_tolerance
+           << " stop=" << cfg.stop.first_miss << ':' << cfg.stop.miss_count << ':'
+           << cfg.stop.miss_task_id << ':' << cfg.stop.max_backlog
+           << " rta=" << static_cast<int>(cfg.rta_mode)
+           << " distributions=" << cfg.export_distributions << " aggregates=" << cfg.export_aggregates;
+        if (cfg.export_aggregates) {
+            id << ':';
+            for (AggregateKey k : cfg.aggregate_keys) id << static_cast<int>(k);
+            id << ':' << cfg.utilization_bucket_width;
+        }
+        id << " outputs=" << outputs.size() << " tasksets=" << tasksets_id
+           << " fingerprint=" << cfg.campaign_fingerprint;
+        const std::string campaign = id.str();
+
+        const std::string path = cfg.journal_path.empty()
+            ? std::filesystem::path(summary_csv_path).replace_extension(".journal").string()
+            : cfg.journal_path;
+        journal_.emplace(path, campaign, outputs);
+        journal_->rollback_outputs();
+
+        // File di fine campagna: dimensione invariata fino alla chiusura.
+        std::size_t i = cfg.rta_mode != RtaMode::Off ? 3 : 2;
+        if (cfg.export_distributions) dist_offset_ = journal_->last().offsets[i++];
+        if (cfg.export_aggregates) agg_offset_ = journal_->last().offsets[i++];
+    }
+
+    // Output scritti fino alle ultime righe esportate, poi commit con lo stato degli accumulatori.
+    void commit(std::int64_t runs_done, bool finished) {
+        BatchJournal::Commit c;
+        c.runs_done = runs_done;
+        c.finished = finished;
+        if (!finished) {
+            csv_->summary().sync();
+            csv_->per_task().sync();
+            if (rta_) rta_->sync();
+        }
+        c.offsets = {csv_->summary().offset(), csv_->per_task().offset()};
+        if (rta_) c.offsets.push_back(rta_->offset());
+        if (distributions_path_) c.offsets.push_back(dist_offset_);
+        if (aggregates_path_) c.offsets.push_back(agg_offset_);
+        journal_->commit(std::move(c), save_state());
+    }
+
+    std::string save_state() const {
+        std::ostringstream os;
+        for (const auto& [policy, tm] : distributions_) {
+            tm.save(os);
+            os << '\n';
+        }
+        if (aggregates_) {
+            aggregates_->save(os);
+            os << '\n';
+        }
+        return os.str();
+    }
+
+    void restore_state() {
+        const std::string state = journal_->load_state();
+        if (state.empty()) {
+            if ((distributions_path_ || aggregates_path_) && journal_->last().runs_done > 0) {
+                throw std::runtime_error("BatchRunner: missing journal state for distributions/aggregates");
+            }
+            return;
+        }
+        std::istringstream is(state);
+        for (auto& [policy, tm] : distributions_) tm.load(is);
+        if (aggregates_) aggregates_->load(is);
+        if (!is) throw std::runtime_error("BatchRunner: invalid journal state");
+    }
+
+    std::uint64_t write_aggregates(const std::string& path) {
+        BufferedFileWriter out(path, false);
+        if (out.was_empty()) out.buffer().append(aggregate_csv_header()).push_back('\n');
+        aggregates_->write_csv(out.buffer());
+        out.close();
+        return out.offset();
+    }
+
+    std::uint64_t write_distributions(const std::string& path) {
+        BufferedFileWriter out(path, false);
+        std::string& line = out.buffer();
+        if (out.was_empty()) line.append(distribution_csv_header()).push_back('\n');
+
+        for (const auto& [policy, tm] : distributions_) {
+            line.append(policy_name(policy));           line.push_back(',');
+            append_int(line, tm.jobs_completed);        line.push_back(',');
+            append_int(line, tm.deadline_miss);         line.push_back(',');
+            append_fixed6(line, tm.avg_response_time()); line.push_back(',');
+            append_int(line, tm.rt_hist.quantile(0.50)); line.push_back(',');
+            append_int(line, tm.rt_hist.quantile(0.90)); line.push_back(',');
+            append_int(line, tm.rt_hist.quantile(0.99)); line.push_back(',');
+            append_int(line, tm.rt_hist.quantile(0.999)); line.push_back(',');
+            append_int(line, tm.rt_max);                line.push_back(',');
+            append_int(line, tm.late_hist.quantile(0.99)); line.push_back(',');
+            append_int(line, tm.lateness_max);          line.push_back(',');
+            append_int(line, tm.start_hist.quantile(0.99)); line.push_back(',');
+            append_int(line, tm.start_hist.max());
+            line.push_back('\n');
+        }
+        out.close();
+        return out.offset();
+    }
+
+    std::optional<CsvExporter> csv_;
+    std::optional<BinaryExporter> binary_;
+    std::optional<BufferedFileWriter> rta_;
+    std::optional<std::string> distributions_path_;
+    std::vector<std::pair<SchedPolicy, TaskMetrics>> distributions_;
+    std::optional<std::string> aggregates_path_;
+    std::optional<BatchAggregator> aggregates_;
+
+    std::int64_t run_id_offset_ = 0;
+
+    std::optional<BatchJournal> journal_;
+    std::int64_t runs_total_ = 0;
+    double checkpoint_interval_ = 0.0;
+    std::chrono::steady_clock::time_point last_commit_;
+    std::uint64_t dist_offset_ = 0;
+    std::uint64_t agg_offset_ = 0;
 };
 
 class BatchRunner {
@@ -95,7 +545,8 @@ private:
                                     std::int64_t runs_total,
                                     tick_t ticks_done,
                                     tick_t total_ticks,
-                                    const std::chrono::steady_clock::time_point& start_time) {
+                                    const std::chrono::steady_clock::time_point& start_time,
+                                    bool estimated_total = false) {
         const auto now = std::chrono::steady_clock::now();
         const double elapsed =
             std::chrono::duration_cast<std::chrono::duration<double>>(now - start_time).count();
@@ -116,12 +567,526 @@ private:
         std::cout << "\r[Batch] "
                   << runs_done << "/" << runs_total
                   << " runs"
-                  << " | ticks " << ticks_done << "/" << total_ticks
+                  << " | ticks " << ticks_done << "/" << (estimated_total ? "~" : "") << total_ticks
                   << " | " << std::fixed << std::setprecision(1) << progress << "%"
                   << " | ETA " << format_seconds(eta)
                   << std::flush;
     }
 
+    struct PolicyRun {
+        SchedPolicy policy = SchedPolicy::FPP;
+        SimulationMetrics metrics;
+    };
+
+    // Esito di una run: metriche simulate per politica e/o risultato RTA
+    // (secondo BatchConfig::policies e BatchConfig::rta_mode).
+    struct RunOutcome {
+        std::vector<PolicyRun> sims;
+        std::optional<RtaResult> rta;
+    };
+
+    template <typename Policy>
+    static SimulationMetrics simulate(const std::vector<Task>& tasks,
+                                      tick_t horizon,
+                                      const BatchConfig& cfg,
+                                      bool console_output) {
+        if (cfg.cores > 1) return simulate_multicore<Policy>(tasks, horizon, cfg, console_output);
+
+        BasicSimulator<Policy> sim(tasks, horizon, cfg.engine);
+        sim.set_steady_state(cfg.steady_state);
+        sim.set_switch_overhead(cfg.switch_overhead);
+        sim.set_histograms(histograms_enabled(cfg));
+        sim.set_stop_conditions(cfg.stop);
+        if (console_output) {
+            sim.run(cfg.debug_timeline, cfg.print_input_each_run, cfg.print_summary_each_run);
+        } else {
+            sim.run(false, false, false);
+        }
+
+        SimulationMetrics m = sim.metrics();
+        if (cfg.breakdown_search) {
+            BreakdownConfig bcfg;
+            bcfg.tolerance = cfg.breakdown_tolerance;
+            bcfg.engine = cfg.engine;
+            bcfg.steady_state = cfg.steady_state;
+            bcfg.switch_overhead = cfg.switch_overhead;
+            // Warm start: un miss nella run principale esclude già alpha >= 1.
+            const auto at_one = m.missed_deadline() ? std::optional<bool>(false) : std::nullopt;
+            const BreakdownResult b = breakdown_search<Policy>(tasks, horizon, bcfg, at_one);
+            m.critical_scaling = b.critical_scaling;
+            m.breakdown_utilization = b.breakdown_utilization;
+        }
+        return m;
+    }
+
+    template <typename Policy>
+    static SimulationMetrics simulate_multicore(const std::vector<Task>& tasks,
+                                                tick_t horizon,
+                                                const BatchConfig& cfg,
+                                                bool console_output) {
+        const bool print_input = console_output && cfg.print_input_each_run;
+        const bool print_summary = console_output && cfg.print_summary_each_run;
+
+        if (cfg.breakdown_search) {
+            throw std::invalid_argument("BatchRunner: breakdown search is supported only with cores = 1");
+        }
+        if (cfg.stop.any()) {
+            throw std::invalid_argument("BatchRunner: stop conditions are supported only with cores = 1");
+        }
+
+        if (cfg.mp_scheduling == MpScheduling::Partitioned) {
+            PartitionedSimulator<Policy> sim(tasks, horizon, cfg.cores, cfg.partition_heuristic, cfg.engine);
+            sim.set_steady_state(cfg.steady_state);
+            sim.set_switch_overhead(cfg.switch_overhead);
+            sim.set_histograms(histograms_enabled(cfg));
+            sim.run(print_input, print_summary);
+            return sim.metrics();
+        }
+
+        if constexpr (std::is_same_v<Policy, PolicyFPP> || std::is_same_v<Policy, PolicyDM>) {
+            if (cfg.switch_overhead > 0) {
+                throw std::invalid_argument("BatchRunner: switch overhead is not supported with global multiprocessor scheduling");
+            }
+            GlobalSimulator<Policy> sim(tasks, horizon, cfg.cores, cfg.engine);
+            sim.set_histograms(histograms_enabled(cfg));
+            sim.run(print_input, print_summary);
+            return sim.metrics();
+        } else {
+            throw std::invalid_argument(std::string("BatchRunner: global multiprocessor scheduling supports only FPP and DM, not ")
+                                        + Policy::name);
+        }
+    }
+
+    static SimulationMetrics simulate(SchedPolicy policy,
+                                      const std::vector<Task>& tasks,
+                                      tick_t horizon,
+                                      const BatchConfig& cfg,
+                                      bool console_output) {
+        switch (policy) {
+            case SchedPolicy::FPP: return simulate<PolicyFPP>(tasks, horizon, cfg, console_output);
+            case SchedPolicy::DM:  return simulate<PolicyDM>(tasks, horizon, cfg, console_output);
+            case SchedPolicy::EDF: return simulate<PolicyEDF>(tasks, horizon, cfg, console_output);
+            case SchedPolicy::LLF: return simulate<PolicyLLF>(tasks, horizon, cfg, console_output);
+        }
+        throw std::invalid_argument("BatchRunner: unknown scheduling policy");
+    }
+
+    // Run di FPP scartata senza simularla: la RTA esatta dimostra un deadline miss.
+    static bool rta_prefiltered(SchedPolicy policy, const BatchConfig& cfg, const RunOutcome& out) {
+        return policy == SchedPolicy::FPP && cfg.cores <= 1 && cfg.rta_mode == RtaMode::Prefilter &&
+               out.rta->exact && !out.rta->schedulable;
+    }
+
+    // Aggiunge a `out` la run della politica: scartata dalla RTA (Prefilter), già simulata
+    // (`simulated`, es. in lockstep) o simulata qui; con CrossCheck ne verifica i WCRT.
+    static void add_policy_run(RunOutcome& out,
+                               SchedPolicy policy,
+                               const std::vector<Task>& tasks,
+                               tick_t horizon,
+                               const BatchConfig& cfg,
+                               bool console_output,
+                               SimulationMetrics* simulated = nullptr) {
+        if (rta_prefiltered(policy, cfg, out)) {
+            SimulationMetrics m;
+            m.init_from_tasks(tasks, horizon, 1, histograms_enabled(cfg));
+            m.stop_tick = 0;
+            m.stop_reason = StopReason::RtaUnschedulable;
+            out.sims.push_back({policy, std::move(m)});
+            return;
+        }
+
+        if (simulated) out.sims.push_back({policy, std::move(*simulated)});
+        else out.sims.push_back({policy, simulate(policy, tasks, horizon, cfg, console_output)});
+
+        if (policy == SchedPolicy::FPP && cfg.cores <= 1 && cfg.rta_mode == RtaMode::CrossCheck) {
+            const std::string violation = rta_cross_check(tasks, *out.rta, out.sims.back().metrics);
+            if (!violation.empty()) throw std::logic_error("RTA cross-check failed: " + violation);
+        }
+    }
+
+    static RunOutcome execute_run(const std::vector<Task>& tasks,
+                                  tick_t horizon,
+                                  const BatchConfig& cfg,
+                                  bool console_output) {
+        RunOutcome out;
+
+        if (cfg.rta_mode != RtaMode::Off) {
+            out.rta = response_time_analysis(tasks);
+            if (cfg.rta_mode == RtaMode::Replace) return out;
+        }
+
+        out.sims.reserve(cfg.policies.size());
+        for (SchedPolicy policy : cfg.policies) {
+            add_policy_run(out, policy, tasks, horizon, cfg, console_output);
+        }
+
+        return out;
+    }
+
+    // Run per blocco di lavoro: lockstep_block_runs se il lockstep è utilizzabile, altrimenti 1.
+    static constexpr std::size_t lockstep_block_runs = 16 * lockstep_lanes;
+
+    static bool per_run_output(const BatchConfig& cfg) {
+        return cfg.debug_timeline || cfg.print_input_each_run || cfg.print_summary_each_run;
+    }
+
+    static bool lockstep_enabled(const BatchConfig& cfg) {
+        return cfg.lockstep && lockstep_max_tasks > 0 && !per_run_output(cfg) && cfg.cores <= 1 &&
+               !cfg.steady_state && cfg.switch_overhead == 0 && !cfg.stop.any() &&
+               !cfg.breakdown_search && !histograms_enabled(cfg);
+    }
+
+    static std::size_t block_runs(const BatchConfig& cfg) {
+        return lockstep_enabled(cfg) ? lockstep_block_runs : 1;
+    }
+
+    template <typename Policy>
+    static std::vector<SimulationMetrics> simulate_lockstep(const std::vector<const std::vector<Task>*>& tasksets,
+                                                            const std::vector<tick_t>& horizons,
+                                                            const std::vector<std::size_t>& selected) {
+        std::vector<std::vector<Task>> sets;
+        std::vector<tick_t> hs;
+        sets.reserve(selected.size());
+        hs.reserve(selected.size());
+        for (const std::size_t k : selected) {
+            sets.push_back(*tasksets[k]);
+            hs.push_back(horizons[k]);
+        }
+        LockstepSimulator<Policy> sim(std::move(sets), std::move(hs));
+        sim.run();
+        return sim.metrics();
+    }
+
+    // Blocco di run senza output su console, stessi risultati di execute_run run per run:
+    // per FPP, DM ed EDF i task set piccoli del blocco sono simulati insieme in lockstep.
+    static std::vector<RunOutcome> execute_block(const std::vector<const std::vector<Task>*>& tasksets,
+                                                 const std::vector<tick_t>& horizons,
+                                                 const BatchConfig& cfg) {
+        std::vector<RunOutcome> outs(tasksets.size());
+        if (!lockstep_enabled(cfg)) {
+            for (std::size_t k = 0; k < tasksets.size(); ++k) {
+                outs[k] = execute_run(*tasksets[k], horizons[k], cfg, false);
+            }
+            return outs;
+        }
+
+        if (cfg.rta_mode != RtaMode::Off) {
+            for (std::size_t k = 0; k < tasksets.size(); ++k) outs[k].rta = response_time_analysis(*tasksets[k]);
+            if (cfg.rta_mode == RtaMode::Replace) return outs;
+        }
+
+        for (auto& out : outs) out.sims.reserve(cfg.policies.size());
+        for (SchedPolicy policy : cfg.policies) {
+            std::vector<std::size_t> selected;
+            if (policy != SchedPolicy::LLF) {
+                for (std::size_t k = 0; k < tasksets.size(); ++k) {
+                    if (tasksets[k]->size() <= lockstep_max_tasks && !rta_prefiltered(policy, cfg, outs[k])) {
+                        selected.push_back(k);
+                    }
+                }
+            }
+
+            std::vector<SimulationMetrics> lockstep;
+            if (!selected.empty()) {
+                switch (policy) {
+                    case SchedPolicy::FPP: lockstep = simulate_lockstep<PolicyFPP>(tasksets, horizons, selected); break;
+                    case SchedPolicy::DM:  lockstep = simulate_lockstep<PolicyDM>(tasksets, horizons, selected); break;
+                    case SchedPolicy::EDF: lockstep = simulate_lockstep<PolicyEDF>(tasksets, horizons, selected); break;
+                    case SchedPolicy::LLF: break;
+                }
+            }
+
+            std::size_t next = 0;
+            for (std::size_t k = 0; k < tasksets.size(); ++k) {
+                const bool in_lockstep = next < selected.size() && selected[next] == k;
+                add_policy_run(outs[k], policy, *tasksets[k], horizons[k], cfg, false,
+                               in_lockstep ? &lockstep[next++] : nullptr);
+            }
+        }
+        return outs;
+    }
+
+    static void export_run(ResultsExporter& exporter,
+                           std::int64_t run_id,
+                           const std::vector<Task>& tasks,
+                           const RunOutcome& outcome) {
+        for (const auto& sim : outcome.sims) {
+            exporter.write_run(run_id, tasks, sim.metrics, policy_name(sim.policy));
+            exporter.accumulate(sim.policy, tasks, sim.metrics);
+        }
+        if (outcome.rta) exporter.write_rta(run_id, tasks, *outcome.rta);
+        exporter.end_run(run_id);
+    }
+
+    static void report_progress(const BatchConfig& cfg,
+                                std::int64_t runs_done,
+                                std::int64_t runs_total,
+                                tick_t ticks_done,
+                                tick_t total_ticks,
+                                const std::chrono::steady_clock::time_point& start_time,
+                                bool estimated_total = false) {
+        if (!cfg.print_progress) return;
+
+        const std::size_t step = std::max<std::size_t>(1, cfg.progress_every_runs);
+        const bool must_print =
+            ((runs_done % static_cast<std::int64_t>(step)) == 0) ||
+            (runs_done == runs_total);
+
+        if (must_print) {
+            print_progress_line(runs_done, runs_total, ticks_done, total_ticks, start_time, estimated_total);
+        }
+    }
+
+    // Impronta FNV-1a dei task set materializzati (parametri di tutti i task), per il journal.
+    static std::string tasksets_hash(const std::vector<std::vector<Task>>& tasksets) {
+        std::uint64_t h = 1469598103934665603ull;
+        const auto mix = [&](std::int64_t v) {
+            for (int b = 0; b < 8; ++b) {
+                h ^= static_cast<std::uint64_t>(v >> (8 * b)) & 0xffu;
+                h *= 1099511628211ull;
+            }
+        };
+        for (const auto& tasks : tasksets) {
+            mix(static_cast<std::int64_t>(tasks.size()));
+            for (const auto& t : tasks) {
+                mix(t.id); mix(t.period); mix(t.deadline); mix(t.wcet); mix(t.priority); mix(t.offset);
+            }
+        }
+        std::ostringstream os;
+        os << std::hex << std::setw(16) << std::setfill('0') << h;
+        return os.str();
+    }
+
+    static void report_resume(const BatchConfig& cfg, std::int64_t first_run, std::int64_t runs_total) {
+        if (cfg.print_progress && first_run > 0) {
+            std::cout << "[Batch] Resuming from journal: " << first_run << "/" << runs_total
+                      << " runs already exported\n";
+        }
+    }
+
+    static void run_sequential(const std::vector<std::vector<Task>>& tasksets,
+                               const std::vector<tick_t>& horizons,
+                               tick_t total_ticks,
+                               const BatchConfig& cfg,
+                               ResultsExporter& exporter) {
+        tick_t ticks_done = 0;
+        const auto start_time = std::chrono::steady_clock::now();
+        const auto runs_total = static_cast<std::int64_t>(tasksets.size());
+
+        const auto block = static_cast<std::int64_t>(block_runs(cfg));
+
+        for (std::int64_t first = exporter.first_run(); first < runs_total; first += block) {
+            const std::int64_t last = std::min(runs_total, first + block);
+            std::vector<RunOutcome> outcomes;
+            if (block == 1) {
+                outcomes.push_back(execute_run(tasksets[first], horizons[first], cfg, true));
+            } else {
+                std::vector<const std::vector<Task>*> sets;
+                for (std::int64_t run_id = first; run_id < last; ++run_id) sets.push_back(&tasksets[run_id]);
+                outcomes = execute_block(sets, {horizons.begin() + first, horizons.begin() + last}, cfg);
+            }
+
+            for (std::int64_t run_id = first; run_id < last; ++run_id) {
+                export_run(exporter, run_id, tasksets[run_id], outcomes[run_id - first]);
+
+                ticks_done += horizons[run_id];
+                report_progress(cfg, run_id + 1, runs_total, ticks_done, total_ticks, start_time);
+            }
+        }
+    }
+
+    // I worker simulano in qualsiasi ordine (a blocchi di block_runs run); il thread
+    // chiamante esporta i risultati in ordine di run_id non appena il prossimo risultato
+    // atteso è disponibile.
+    static void run_parallel(const std::vector<std::vector<Task>>& tasksets,
+                             const std::vector<tick_t>& horizons,
+                             tick_t total_ticks,
+                             const BatchConfig& cfg,
+                             std::size_t workers,
+                             ResultsExporter& exporter) {
+        const auto runs_total = static_cast<std::int64_t>(tasksets.size());
+        const std::int64_t first = exporter.first_run();
+
+        std::vector<std::optional<RunOutcome>> results(tasksets.size());
+        std::mutex m;
+        std::condition_variable cv;
+        bool producer_done = false;
+        std::exception_ptr error;
+
+        std::jthread producer([&] {
+            try {
+                const std::size_t block = block_runs(cfg);
+                const auto pending = static_cast<std::size_t>(runs_total - first);
+                WorkStealingPool pool(workers);
+                pool.run((pending + block - 1) / block, [&](std::size_t b, std::size_t) {
+                    const std::size_t begin = static_cast<std::size_t>(first) + b * block;
+                    const std::size_t end = std::min(tasksets.size(), begin + block);
+                    std::vector<const std::vector<Task>*> sets;
+                    for (std::size_t run_id = begin; run_id < end; ++run_id) sets.push_back(&tasksets[run_id]);
+                    std::vector<RunOutcome> outcomes =
+                        execute_block(sets, {horizons.begin() + begin, horizons.begin() + end}, cfg);
+
+                    std::lock_guard<std::mutex> lock(m);
+                    for (std::size_t run_id = begin; run_id < end; ++run_id) {
+                        results[run_id] = std::move(outcomes[run_id - begin]);
+                    }
+                    cv.notify_one();
+                });
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m);
+                error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(m);
+            producer_done = true;
+            cv.notify_one();
+        });
+
+        tick_t ticks_done = 0;
+        const auto start_time = std::chrono::steady_clock::now();
+
+        for (std::int64_t run_id = first; run_id < runs_total; ++run_id) {
+            RunOutcome outcome;
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait(lock, [&] { return results[run_id].has_value() || producer_done; });
+                if (!results[run_id].has_value()) {
+                    if (error) std::rethrow_exception(error);
+                    throw std::logic_error("BatchRunner: missing result for run " + std::to_string(run_id));
+                }
+                outcome = std::move(*results[run_id]);
+                results[run_id].reset();
+            }
+
+            export_run(exporter, run_id, tasksets[run_id], outcome);
+
+            ticks_done += horizons[run_id];
+            report_progress(cfg, run_id + 1, runs_total, ticks_done, total_ticks, start_time);
+        }
+    }
+
+    // Totale tick stimato dalla media delle run già completate (horizon non pre-calcolati).
+    static tick_t estimate_total_ticks(tick_t ticks_done, std::int64_t runs_done, std::int64_t runs_total) {
+        if (runs_done <= 0) return 0;
+        if (runs_done >= runs_total) return ticks_done;
+        const double avg = static_cast<double>(ticks_done) / static_cast<double>(runs_done);
+        return static_cast<tick_t>(avg * static_cast<double>(runs_total));
+    }
+
+    struct StreamResult {
+        std::vector<Task> tasks;
+        tick_t horizon = 0;
+        RunOutcome outcome;
+    };
+
+    // I worker prendono i run_id in ordine (a blocchi di block_runs run) e possono avanzare
+    // al massimo `window` run oltre la prossima da esportare: memoria limitata
+    // indipendentemente dalla campagna.
+    template <typename Source>
+    static void run_stream_parallel(const Source& source,
+                                    const BatchConfig& cfg,
+                                    std::size_t workers,
+                                    ResultsExporter& exporter) {
+        const auto runs_total = static_cast<std::int64_t>(source.size());
+        const auto block = static_cast<std::int64_t>(block_runs(cfg));
+        const auto window = std::max<std::int64_t>(block, static_cast<std::int64_t>(
+            cfg.max_in_flight > 0 ? cfg.max_in_flight : 4 * workers * static_cast<std::size_t>(block)));
+
+        const std::int64_t first = exporter.first_run();
+
+        std::vector<std::optional<StreamResult>> slots(static_cast<std::size_t>(window));
+        std::mutex m;
+        std::condition_variable cv_work;
+        std::condition_variable cv_result;
+        std::int64_t next_take = first;
+        std::int64_t next_write = first;
+        bool failed = false;
+        std::exception_ptr error;
+
+        auto worker_loop = [&] {
+            for (;;) {
+                std::int64_t begin;
+                std::int64_t end;
+                {
+                    std::unique_lock<std::mutex> lock(m);
+                    cv_work.wait(lock, [&] {
+                        return failed || next_take >= runs_total ||
+                               std::min(runs_total, next_take + block) - next_write <= window;
+                    });
+                    if (failed || next_take >= runs_total) return;
+                    begin = next_take;
+                    end = std::min(runs_total, next_take + block);
+                    next_take = end;
+                }
+
+                try {
+                    std::vector<StreamResult> rs(static_cast<std::size_t>(end - begin));
+                    std::vector<const std::vector<Task>*> sets;
+                    std::vector<tick_t> horizons;
+                    for (auto& r : rs) {
+                        r.tasks = source.make(static_cast<std::uint64_t>(begin + (&r - rs.data())));
+                        r.horizon = resolve_horizon(r.tasks, cfg);
+                        sets.push_back(&r.tasks);
+                        horizons.push_back(r.horizon);
+                    }
+
+                    std::vector<RunOutcome> outcomes = execute_block(sets, horizons, cfg);
+                    for (std::size_t k = 0; k < rs.size(); ++k) rs[k].outcome = std::move(outcomes[k]);
+
+                    std::lock_guard<std::mutex> lock(m);
+                    for (std::int64_t run_id = begin; run_id < end; ++run_id) {
+                        slots[static_cast<std::size_t>(run_id % window)] = std::move(rs[static_cast<std::size_t>(run_id - begin)]);
+                    }
+                    cv_result.notify_one();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(m);
+                    if (!error) error = std::current_exception();
+                    failed = true;
+                    cv_result.notify_all();
+                    cv_work.notify_all();
+                    return;
+                }
+            }
+        };
+
+        std::vector<std::jthread> threads;
+        threads.reserve(workers);
+        for (std::size_t w = 0; w < workers; ++w) threads.emplace_back(worker_loop);
+
+        tick_t ticks_done = 0;
+        const auto start_time = std::chrono::steady_clock::now();
+
+        try {
+            for (std::int64_t run_id = first; run_id < runs_total; ++run_id) {
+                StreamResult r;
+                {
+                    auto& slot = slots[static_cast<std::size_t>(run_id % window)];
+                    std::unique_lock<std::mutex> lock(m);
+                    cv_result.wait(lock, [&] { return slot.has_value() || failed; });
+                    if (!slot.has_value()) std::rethrow_exception(error);
+                    r = std::move(*slot);
+                    slot.reset();
+                    next_write++;
+                    cv_work.notify_all();
+                }
+
+                export_run(exporter, run_id, r.tasks, r.outcome);
+
+                ticks_done += r.horizon;
+                report_progress(cfg, run_id + 1, runs_total, ticks_done,
+                                estimate_total_ticks(ticks_done, run_id + 1 - first, runs_total - first),
+                                start_time, run_id + 1 < runs_total);
+            }
+        } catch (...) {
+            // Ferma i worker prima del join dei thread.
+            {
+                std::lock_guard<std::mutex> lock(m);
+                failed = true;
+                cv_work.notify_all();
+            }
+            throw;
+        }
+    }
+
 public:
     static void run(const std::vector<std::vector<Task>>& tasksets,
                     const BatchConfig& cfg,
@@ -132,51 +1097,102 @@ public:
             return;
         }
 
+        const std::size_t workers =
+            (cfg.workers == 0) ? WorkStealingPool::default_workers() : cfg.workers;
+
+        ResultsExporter exporter(summary_csv_path, per_task_csv_path, cfg,
+                                 static_cast<std::int64_t>(tasksets.size()),
+                                 cfg.checkpoint ? tasksets_hash(tasksets) : std::string());
+        report_resume(cfg, exporter.first_run(), static_cast<std::int64_t>(tasksets.size()));
+
+        // Solo le run ancora da eseguire contano nel totale del progresso.
         std::vector<tick_t> horizons(tasksets.size(), 0);
         tick_t total_ticks = 0;
 
-        for (size_t i = 0; i < tasksets.size(); ++i) {
+        for (size_t i = static_cast<size_t>(exporter.first_run()); i < tasksets.size(); ++i) {
             horizons[i] = resolve_horizon(tasksets[i], cfg);
             total_ticks += horizons[i];
         }
 
-        tick_t ticks_done = 0;
-        const auto start_time = std::chrono::steady_clock::now();
+        if (workers <= 1 || per_run_output(cfg)) {
+            run_sequential(tasksets, horizons, total_ticks, cfg, exporter);
+        } else {
+            run_parallel(tasksets, horizons, total_ticks, cfg, workers, exporter);
+        }
 
-        for (std::int64_t run_id = 0; run_id < static_cast<std::int64_t>(tasksets.size()); ++run_id) {
-            const auto& tasks = tasksets[run_id];
-            const tick_t horizon = horizons[run_id];
+        exporter.close();
 
-            Simulator sim(tasks, horizon);
-            sim.run(cfg.debug_timeline,
-                    cfg.print_input_each_run,
-                    cfg.print_summary_each_run);
+        if (cfg.print_progress) {
+            std::cout << "\n[Batch] Completed.\n";
+            if (exporter.aggregates()) exporter.aggregates()->print_report(std::cout);
+        }
+    }
+
+    // Pipeline in streaming: `source` deve fornire size() e make(i) (es. SeedRangeSource).
+    // I task set e gli horizon non vengono pre-calcolati: il totale dei tick nel progresso
+    // è stimato dalla media delle run completate.
+    template <typename Source>
+    static void run_stream(const Source& source,
+                           const BatchConfig& cfg,
+                           const std::string& summary_csv_path,
+                           const std::string& per_task_csv_path) {
+        const auto runs_total = static_cast<std::int64_t>(source.size());
+        if (runs_total == 0) {
+            std::cout << "[Batch] No task sets to run.\n";
+            return;
+        }
 
-            append_summary_csv(summary_csv_path, run_id, tasks, sim.metrics(), "FPP");
-            append_per_task_csv(per_task_csv_path, run_id, tasks, sim.metrics(), "FPP");
+        const std::size_t workers =
+            (cfg.workers == 0) ? WorkStealingPool::default_workers() : cfg.workers;
 
-            ticks_done += horizon;
+        ResultsExporter exporter(summary_csv_path, per_task_csv_path, cfg, runs_total);
+        report_resume(cfg, exporter.first_run(), runs_total);
 
-            if (cfg.print_progress) {
-                const std::size_t step = std::max<std::size_t>(1, cfg.progress_every_runs);
-                const bool must_print =
-                    (((run_id + 1) % static_cast<std::int64_t>(step)) == 0) ||
-                    (run_id + 1 == static_cast<std::int64_t>(tasksets.size()));
+        if (workers <= 1 || per_run_output(cfg)) {
+            tick_t ticks_done = 0;
+            const auto start_time = std::chrono::steady_clock::now();
+            const std::int64_t first = exporter.first_run();
+            const auto block = static_cast<std::int64_t>(block_runs(cfg));
 
-                if (must_print) {
-                    print_progress_line(run_id + 1,
-                                        static_cast<std::int64_t>(tasksets.size()),
-                                        ticks_done,
-                                        total_ticks,
-                                        start_time);
+            for (std::int64_t begin = first; begin < runs_total; begin += block) {
+                const std::int64_t end = std::min(runs_total, begin + block);
+                std::vector<std::vector<Task>> tasks;
+                std::vector<tick_t> horizons;
+                for (std::int64_t run_id = begin; run_id < end; ++run_id) {
+                    tasks.push_back(source.make(static_cast<std::uint64_t>(run_id)));
+                    horizons.push_back(resolve_horizon(tasks.back(), cfg));
+                }
+
+                std::vector<RunOutcome> outcomes;
+                if (block == 1) {
+                    outcomes.push_back(execute_run(tasks[0], horizons[0], cfg, true));
+                } else {
+                    std::vector<const std::vector<Task>*> sets;
+                    for (const auto& ts : tasks) sets.push_back(&ts);
+                    outcomes = execute_block(sets, horizons, cfg);
+                }
+
+                for (std::int64_t run_id = begin; run_id < end; ++run_id) {
+                    const auto k = static_cast<std::size_t>(run_id - begin);
+                    export_run(exporter, run_id, tasks[k], outcomes[k]);
+
+                    ticks_done += horizons[k];
+                    report_progress(cfg, run_id + 1, runs_total, ticks_done,
+                                    estimate_total_ticks(ticks_done, run_id + 1 - first, runs_total - first),
+                                    start_time, run_id + 1 < runs_total);
                 }
             }
+        } else {
+            run_stream_parallel(source, cfg, workers, exporter);
         }
 
+        exporter.close();
+
         if (cfg.print_progress) {
             std::cout << "\n[Batch] Completed.\n";
+            if (exporter.aggregates()) exporter.aggregates()->print_report(std::cout);
         }
     }
 };
 
-} // namespace rt
\ No newline at end of file
+} // namespace rt
@@ -0,0 +1,480 @@
+// binary_export.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Formato binario colonnare per i risultati batch (alternativa a summary.csv / per_task.csv).
+// Layout del file (little-endian nativo, tutte le sezioni allineate a 8 byte, mappabile in memoria):
+// - header fisso (64 byte): magic, versione, tipo tabella, numero righe/colonne, offset sezioni
+// - schema: per ogni colonna nome (32 byte), tipo, larghezza e offset assoluto dei dati
+// - dizionario delle policy (la colonna `policy` contiene l'indice nel dizionario)
+// - dati: una colonna contigua a larghezza fissa dopo l'altra
+// Include il convertitore inverso verso il layout CSV attuale (byte per byte).
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "task.hpp"
+#include "metrics.hpp"
+#include "csv_export.hpp"
+
+namespace rt {
+
+enum class BinaryTable : std::uint32_t {
+    Summary = 0,
+    PerTask = 1
+};
+
+enum class ColumnType : std::uint8_t {
+    I64 = 0,
+    F64 = 1,
+    Dict = 2    // indice uint32 nel dizionario delle stringhe
+};
+
+struct ColumnSpec {
+    std::string name;
+    ColumnType type = ColumnType::I64;
+};
+
+inline std::uint8_t column_width(ColumnType type) {
+    return type == ColumnType::Dict ? 4 : 8;
+}
+
+// Schema: stesse colonne, nello stesso ordine, dei CSV.
+inline std::vector<ColumnSpec> summary_binary_schema() {
+    return {
+        {"run_id", ColumnType::I64}, {"policy", ColumnType::Dict}, {"n_tasks", ColumnType::I64},
+        {"horizon", ColumnType::I64}, {"busy_ticks", ColumnType::I64}, {"utilization", ColumnType::F64},
+        {"deadline_miss", ColumnType::I64}, {"unfinished_jobs", ColumnType::I64},
+        {"peak_live_jobs", ColumnType::I64}, {"peak_job_bytes", ColumnType::I64},
+        {"extrapolated_ticks", ColumnType::I64}, {"context_switches", ColumnType::I64},
+        {"preemptions", ColumnType::I64}, {"switch_overhead_ticks", ColumnType::I64},
+        {"cores", ColumnType::I64}, {"migrations", ColumnType::I64},
+        {"core_util_min", ColumnType::F64}, {"core_util_max", ColumnType::F64},
+        {"critical_scaling", ColumnType::F64}, {"breakdown_utilization", ColumnType::F64},
+        {"stop_tick", ColumnType::I64}, {"stop_reason", ColumnType::Dict}
+    };
+}
+
+inline std::vector<ColumnSpec> per_task_binary_schema() {
+    return {
+        {"run_id", ColumnType::I64}, {"policy", ColumnType::Dict}, {"task_index", ColumnType::I64},
+        {"task_id", ColumnType::I64}, {"priority", ColumnType::I64}, {"period", ColumnType::I64},
+        {"deadline", ColumnType::I64}, {"wcet", ColumnType::I64}, {"offset", ColumnType::I64},
+        {"jobs_released", ColumnType::I64}, {"jobs_completed", ColumnType::I64},
+        {"deadline_miss", ColumnType::I64}, {"unfinished", ColumnType::I64},
+        {"rt_avg", ColumnType::F64}, {"rt_max", ColumnType::I64},
+        {"late_avg", ColumnType::F64}, {"late_max", ColumnType::I64},
+        {"rt_p50", ColumnType::I64}, {"rt_p90", ColumnType::I64}, {"rt_p99", ColumnType::I64},
+        {"late_p99", ColumnType::I64}, {"start_p99", ColumnType::I64}, {"start_jitter", ColumnType::I64},
+        {"context_switches", ColumnType::I64}, {"preemptions", ColumnType::I64},
+        {"core", ColumnType::I64}, {"migrations", ColumnType::I64}
+    };
+}
+
+namespace binfmt {
+
+inline constexpr char magic[8] = {'R', 'T', 'C', 'O', 'L', 'S', 'I', 'M'};
+inline constexpr std::uint32_t endian_tag = 0x01020304u;
+inline constexpr std::uint32_t version = 1;
+inline constexpr std::size_t header_size = 64;
+inline constexpr std::size_t column_entry_size = 48;
+inline constexpr std::size_t column_name_size = 32;
+
+inline std::uint64_t align8(std::uint64_t v) { return (v + 7) & ~std::uint64_t{7}; }
+
+template <typename T>
+void put(std::vector<char>& out, std::size_t pos, T v) {
+    std::memcpy(out.data() + pos, &v, sizeof(T));
+}
+
+template <typename T>
+T get(const char* base, std::size_t pos) {
+    T v;
+    std::memcpy(&v, base + pos, sizeof(T));
+    return v;
+}
+
+} // namespace binfmt
+
+// Scrittore di una tabella colonnare. Le righe arrivano in streaming: ogni colonna
+// viene accumulata in un buffer e riversata in un file temporaneo quando supera
+// `spill_size`; close() assembla header, schema, dizionario e colonne nel file finale.
+class ColumnarTableWriter {
+public:
+    static constexpr std::size_t spill_size = std::size_t{1} << 20; // 1 MiB per colonna
+
+    ColumnarTableWriter(const std::string& path, BinaryTable table, std::vector<ColumnSpec> schema)
+        : path_(path), table_(table), schema_(std::move(schema)), columns_(schema_.size())
+    {
+        for (size_t c = 0; c < schema_.size(); ++c) {
+            if (schema_[c].name.size() >= binfmt::column_name_size) {
+                throw std::invalid_argument("Column name too long: " + schema_[c].name);
+            }
+            columns_[c].tmp_path = path_ + ".col" + std::to_string(c) + ".tmp";
+            std::filesystem::remove(columns_[c].tmp_path);
+        }
+    }
+
+    ColumnarTableWriter(const ColumnarTableWriter&) = delete;
+    ColumnarTableWriter& operator=(const ColumnarTableWriter&) = delete;
+
+    ~ColumnarTableWriter() {
+        try {
+            close();
+        } catch (...) {
+            // Errori nel distruttore non possono essere propagati.
+        }
+    }
+
+    void put_i64(std::size_t col, std::int64_t v) { append(col, &v, sizeof(v)); }
+    void put_f64(std::size_t col, double v) { append(col, &v, sizeof(v)); }
+
+    void put_dict(std::size_t col, const std::string& s) {
+        std::uint32_t idx = 0;
+        while (idx < dict_.size() && dict_[idx] != s) idx++;
+        if (idx == dict_.size()) dict_.push_back(s);
+        append(col, &idx, sizeof(idx));
+    }
+
+    // Da chiamare dopo aver scritto tutte le colonne di una riga.
+    void end_row() { rows_++; }
+
+    std::uint64_t rows() const { return rows_; }
+
+    void close() {
+        if (closed_) return;
+        closed_ = true;
+
+        for (auto& col : columns_) {
+            if (col.spill.is_open()) {
+                col.spill.close();
+                if (col.spill.fail()) throw std::runtime_error("Error writing temp file: " + col.tmp_path);
+            }
+        }
+
+        // Layout delle sezioni
+        const std::uint64_t schema_offset = binfmt::header_size;
+        const std::uint64_t dict_offset = schema_offset + schema_.size() * binfmt::column_entry_size;
+        std::uint64_t dict_size = 0;
+        for (const auto& s : dict_) dict_size += 4 + s.size();
+        std::uint64_t data_offset = binfmt::align8(dict_offset + dict_size);
+
+        std::vector<std::uint64_t> col_offsets(schema_.size());
+        std::uint64_t pos = data_offset;
+        for (size_t c = 0; c < schema_.size(); ++c) {
+            col_offsets[c] = pos;
+            pos = binfmt::align8(pos + rows_ * column_width(schema_[c].type));
+        }
+
+        std::vector<char> head(data_offset, 0);
+        std::memcpy(head.data(), binfmt::magic, sizeof(binfmt::magic));
+        binfmt::put<std::uint32_t>(head, 8, binfmt::endian_tag);
+        binfmt::put<std::uint32_t>(head, 12, binfmt::version);
+        binfmt::put<std::uint64_t>(head, 16, rows_);
+        binfmt::put<std::uint32_t>(head, 24, static_cast<std::uint32_t>(schema_.size()));
+        binfmt::put<std::uint32_t>(head, 28, static_cast<std::uint32_t>(dict_.size()));
+        binfmt::put<std::uint64_t>(head, 32, schema_offset);
+        binfmt::put<std::uint64_t>(head, 40, dict_offset);
+        binfmt::put<std::uint64_t>(head, 48, data_offset);
+        binfmt::put<std::uint32_t>(head, 56, static_cast<std::uint32_t>(table_));
+
+        for (size_t c = 0; c < schema_.size(); ++c) {
+            const std::size_t e = schema_offset + c * binfmt::column_entry_size;
+            std::memcpy(head.data() + e, schema_[c].name.data(), schema_[c].name.size());
+            head[e + binfmt::column_name_size] = static_cast<char>(schema_[c].type);
+            head[e + binfmt::column_name_size + 1] = static_cast<char>(column_width(schema_[c].type));
+            binfmt::put<std::uint64_t>(head, e + 40, col_offsets[c]);
+        }
+
+        std::size_t d = dict_offset;
+        for (const auto& s : dict_) {
+            binfmt::put<std::uint32_t>(head, d, static_cast<std::uint32_t>(s.size()));
+            std::memcpy(head.data() + d + 4, s.data(), s.size());
+            d += 4 + s.size();
+        }
+
+        std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("Cannot open binary results file: " + path_);
+        out.write(head.data(), static_cast<std::streamsize>(head.size()));
+
+        static constexpr char zeros[8] = {};
+        for (size_t c = 0; c < schema_.size(); ++c) {
+            auto& col = columns_[c];
+            std::uint64_t written = 0;
+
+            if (col.spilled > 0) {
+                std::ifstream in(col.tmp_path, std::ios::binary);
+                out << in.rdbuf();
+                written += col.spilled;
+            }
+            out.write(col.buffer.data(), static_cast<std::streamsize>(col.buffer.size()));
+            written += col.buffer.size();
+
+            const std::uint64_t pad = binfmt::align8(written) - written;
+            out.write(zeros, static_cast<std::streamsize>(pad));
+
+            std::filesystem::remove(col.tmp_path);
+        }
+
+        out.close();
+        if (out.fail()) throw std::runtime_error("Error writing binary results file: " + path_);
+    }
+
+private:
+    struct ColumnBuffer {
+        std::vector<char> buffer;
+        std::string tmp_path;
+        std::ofstream spill;
+        std::uint64_t spilled = 0;
+    };
+
+    void append(std::size_t col, const void* data, std::size_t n) {
+        auto& c = columns_[col];
+        const auto* p = static_cast<const char*>(data);
+        c.buffer.insert(c.buffer.end(), p, p + n);
+
+        if (c.buffer.size() >= spill_size) {
+            if (!c.spill.is_open()) {
+                c.spill.open(c.tmp_path, std::ios::binary | std::ios::trunc);
+                if (!c.spill) throw std::runtime_error("Cannot open temp file: " + c.tmp_path);
+            }
+            c.spill.write(c.buffer.data(), static_cast<std::streamsize>(c.buffer.size()));
+            c.spilled += c.buffer.size();
+            c.buffer.clear();
+        }
+    }
+
+    std::string path_;
+    BinaryTable table_;
+    std::vector<ColumnSpec> schema_;
+    std::vector<ColumnBuffer> columns_;
+    std::vector<std::string> dict_;
+    std::uint64_t rows_ = 0;
+    bool closed_ = false;
+};
+
+// Exporter binario con la stessa interfaccia di CsvExporter.
+// A differenza dei CSV il file viene riscritto (non accodato) a ogni campagna.
+class BinaryExporter {
+public:
+    BinaryExporter(const std::string& summary_path, const std::string& per_task_path)
+        : summary_(summary_path, BinaryTable::Summary, summary_binary_schema()),
+          per_task_(per_task_path, BinaryTable::PerTask, per_task_binary_schema()) {}
+
+    void write_run(std::int64_t run_id,
+                   const std::vector<Task>& tasks,
+                   const SimulationMetrics& m,
+                   const std::string& policy = "FPP")
+    {
+        std::size_t c = 0;
+        summary_.put_i64(c++, run_id);
+        summary_.put_dict(c++, policy);
+        summary_.put_i64(c++, static_cast<std::int64_t>(tasks.size()));
+        summary_.put_i64(c++, m.horizon);
+        summary_.put_i64(c++, m.busy_ticks);
+        summary_.put_f64(c++, m.utilization());
+        summary_.put_i64(c++, m.deadline_miss_total);
+        summary_.put_i64(c++, m.unfinished_total);
+        summary_.put_i64(c++, m.peak_live_jobs);
+        summary_.put_i64(c++, m.peak_job_bytes);
+        summary_.put_i64(c++, m.extrapolated_ticks);
+        summary_.put_i64(c++, m.context_switches);
+        summary_.put_i64(c++, m.preemptions_total);
+        summary_.put_i64(c++, m.switch_overhead_ticks);
+        summary_.put_i64(c++, static_cast<std::int64_t>(m.cores()));
+        summary_.put_i64(c++, m.migrations);
+        summary_.put_f64(c++, m.core_utilization_min());
+        summary_.put_f64(c++, m.core_utilization_max());
+        summary_.put_f64(c++, m.critical_scaling);
+        summary_.put_f64(c++, m.breakdown_utilization);
+        summary_.put_i64(c++, m.stop_tick);
+        summary_.put_dict(c++, stop_reason_name(m.stop_reason));
+        summary_.end_row();
+
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            const auto& t = tasks[i];
+            const auto& tm = m.per_task[i];
+
+            c = 0;
+            per_task_.put_i64(c++, run_id);
+            per_task_.put_dict(c++, policy);
+            per_task_.put_i64(c++, static_cast<std::int64_t>(i));
+            per_task_.put_i64(c++, t.id);
+            per_task_.put_i64(c++, t.priority);
+            per_task_.put_i64(c++, t.period);
+            per_task_.put_i64(c++, t.deadline);
+            per_task_.put_i64(c++, t.wcet);
+            per_task_.put_i64(c++, t.offset);
+            per_task_.put_i64(c++, tm.jobs_released);
+            per_task_.put_i64(c++, tm.jobs_completed);
+            per_task_.put_i64(c++, tm.deadline_miss);
+            per_task_.put_i64(c++, tm.unfinished);
+            per_task_.put_f64(c++, tm.avg_response_time());
+            per_task_.put_i64(c++, tm.rt_max);
+            per_task_.put_f64(c++, tm.avg_lateness());
+            per_task_.put_i64(c++, tm.lateness_max);
+            per_task_.put_i64(c++, tm.rt_quantile(0.50));
+            per_task_.put_i64(c++, tm.rt_quantile(0.90));
+            per_task_.put_i64(c++, tm.rt_quantile(0.99));
+            per_task_.put_i64(c++, tm.late_quantile(0.99));
+            per_task_.put_i64(c++, tm.start_quantile(0.99));
+            per_task_.put_i64(c++, tm.start_jitter());
+            per_task_.put_i64(c++, tm.context_switches);
+            per_task_.put_i64(c++, tm.preemptions);
+            per_task_.put_i64(c++, tm.core);
+            per_task_.put_i64(c++, tm.migrations);
+            per_task_.end_row();
+        }
+    }
+
+    void close() {
+        summary_.close();
+        per_task_.close();
+    }
+
+private:
+    ColumnarTableWriter summary_;
+    ColumnarTableWriter per_task_;
+};
+
+// Vista in sola lettura su un file colonnare già in memoria (buffer letto o mappato).
+// Non possiede i dati: il buffer deve sopravvivere alla vista.
+class ColumnarTableView {
+public:
+    struct Column {
+        std::string name;
+        ColumnType type = ColumnType::I64;
+        std::uint64_t offset = 0;
+    };
+
+    ColumnarTableView(const char* data, std::size_t size) : data_(data) {
+        if (size < binfmt::header_size || std::memcmp(data, binfmt::magic, sizeof(binfmt::magic)) != 0) {
+            throw std::runtime_error("Not a binary results file");
+        }
+        if (binfmt::get<std::uint32_t>(data, 8) != binfmt::endian_tag) {
+            throw std::runtime_error("Binary results file has different endianness");
+        }
+        if (binfmt::get<std::uint32_t>(data, 12) != binfmt::version) {
+            throw std::runtime_error("Unsupported binary results version");
+        }
+
+        rows_ = binfmt::get<std::uint64_t>(data, 16);
+        const auto n_cols = binfmt::get<std::uint32_t>(data, 24);
+        const auto n_dict = binfmt::get<std::uint32_t>(data, 28);
+        const auto schema_offset = binfmt::get<std::uint64_t>(data, 32);
+        std::uint64_t d = binfmt::get<std::uint64_t>(data, 40);
+        table_ = static_cast<BinaryTable>(binfmt::get<std::uint32_t>(data, 56));
+
+        // Controlli nella forma a > (size - b) / c: rows e offset arrivano dal file e
+        // b + rows * c potrebbe andare in overflow.
+        if (schema_offset > size || n_cols > (size - schema_offset) / binfmt::column_entry_size) {
+            throw std::runtime_error("Truncated schema");
+        }
+
+        for (std::uint32_t c = 0; c < n_cols; ++c) {
+            const std::size_t e = schema_offset + c * binfmt::column_entry_size;
+
+            Column col;
+            const char* name = data + e;
+            col.name.assign(name, std::find(name, name + binfmt::column_name_size, '\0'));
+            const auto type = static_cast<std::uint8_t>(data[e + binfmt::column_name_size]);
+            if (type > static_cast<std::uint8_t>(ColumnType::Dict)) {
+                throw std::runtime_error("Unknown column type: " + col.name);
+            }
+            col.type = static_cast<ColumnType>(type);
+            col.offset = binfmt::get<std::uint64_t>(data, e + 40);
+            if (col.offset > size || rows_ > (size - col.offset) / column_width(col.type)) {
+                throw std::runtime_error("Truncated column: " + col.name);
+            }
+            columns_.push_back(col);
+        }
+
+        for (std::uint32_t i = 0; i < n_dict; ++i) {
+            if (d > size || size - d < 4) throw std::runtime_error("Truncated dictionary");
+            const auto len = binfmt::get<std::uint32_t>(data, d);
+            if (size - d - 4 < len) throw std::runtime_error("Truncated dictionary");
+            dict_.emplace_back(data + d + 4, len);
+            d += 4 + len;
+        }
+    }
+
+    BinaryTable table() const { return table_; }
+    std::uint64_t rows() const { return rows_; }
+    const std::vector<Column>& columns() const { return columns_; }
+    const std::vector<std::string>& dictionary() const { return dict_; }
+
+    std::int64_t i64(std::size_t col, std::uint64_t row) const {
+        return binfmt::get<std::int64_t>(data_, columns_[col].offset + row * 8);
+    }
+
+    double f64(std::size_t col, std::uint64_t row) const {
+        return binfmt::get<double>(data_, columns_[col].offset + row * 8);
+    }
+
+    const std::string& dict(std::size_t col, std::uint64_t row) const {
+        return dict_.at(binfmt::get<std::uint32_t>(data_, columns_[col].offset + row * 4));
+    }
+
+private:
+    const char* data_;
+    BinaryTable table_ = BinaryTable::Summary;
+    std::uint64_t rows_ = 0;
+    std::vector<Column> columns_;
+    std::vector<std::string> dict_;
+};
+
+// Converte un file colonnare nel CSV corrispondente (stesso header e formattazione
+// di append_summary_csv / append_per_task_csv). Il CSV di destinazione viene sovrascritto.
+inline void binary_to_csv(const std::string& bin_path, const std::string& csv_path) {
+    std::ifstream in(bin_path, std::ios::binary);
+    if (!in) throw std::runtime_error("Cannot open binary results file: " + bin_path);
+    const std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    const ColumnarTableView view(data.data(), data.size());
+
+    std::filesystem::remove(csv_path);
+    BufferedFileWriter out(csv_path, false);
+
+    out.buffer().append(view.table() == BinaryTable::Summary ? summary_csv_header()
+                                                              : per_task_csv_header());
+    out.buffer().push_back('\n');
+
+    char buf[64];
+    for (std::uint64_t r = 0; r < view.rows(); ++r) {
+        std::string& line = out.buffer();
+        for (size_t c = 0; c < view.columns().size(); ++c) {
+            if (c > 0) line.push_back(',');
+            switch (view.columns()[c].type) {
+                case ColumnType::I64: {
+                    const auto res = std::to_chars(buf, buf + sizeof(buf), view.i64(c, r));
+                    line.append(buf, res.ptr);
+                    break;
+                }
+                case ColumnType::F64: {
+                    const auto res = std::to_chars(buf, buf + sizeof(buf), view.f64(c, r),
+                                                   std::chars_format::fixed, 6);
+                    line.append(buf, res.ptr);
+                    break;
+                }
+                case ColumnType::Dict:
+                    line.append(view.dict(c, r));
+                    break;
+            }
+        }
+        line.push_back('\n');
+        out.maybe_flush();
+    }
+
+    out.close();
+}
+
+} // namespace rt
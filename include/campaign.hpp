@@ -0,0 +1,399 @@
+// campaign.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Campagne batch suddivise in shard, eseguiti come processi indipendenti (anche su
+// macchine diverse) e poi fusi nei CSV canonici:
+// - CampaignSpec: generatore, intervallo di seed, politiche, modalità di horizon; letta
+//   da un file di testo "chiave = valore" (load_campaign)
+// - shard_of: intervalli contigui di seed bilanciati (le prime count % n shard hanno una
+//   run in più); la run i della campagna usa il seed first_seed + i e ha run_id i
+// - run_shard: simula uno shard in "<out_dir>/shard-<i>-of-<n>/" con run_id globali
+//   (BatchConfig::run_id_offset) e checkpoint (batch_journal.hpp), poi scrive il manifest
+//   "shard.done" con l'intervallo di run completato e la campagna in forma canonica
+//   (format_campaign): uno shard di una campagna diversa nella stessa directory è un errore
+// - merge_shards: verifica che i manifest coprano tutta la campagna e fonde i CSV degli
+//   shard (summary, per-task, RTA) in "<out_dir>/summary.csv" e "<out_dir>/per_task.csv",
+//   ordinati per run_id, con un merge a k vie in streaming
+// Il risultato è identico byte per byte a quello della campagna in un solo processo.
+// Distribuzioni e aggregati restano per shard (i quantili non sono fondibili dai CSV).
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <charconv>
+#include <filesystem>
+#include <stdexcept>
+#include <algorithm>
+#include <string_view>
+#include <iterator>
+
+#include "task.hpp"
+#include "scheduler.hpp"
+#include "taskset_generator.hpp"
+#include "batch_runner.hpp"
+#include "csv_export.hpp"
+
+namespace rt {
+
+struct CampaignSpec {
+    GeneratorConfig generator;      // il seed è assegnato run per run
+    std::uint32_t first_seed = 1;
+    std::uint64_t count = 0;        // numero di task set (run) della campagna
+
+    std::vector<SchedPolicy> policies = {SchedPolicy::FPP};
+    HorizonMode horizon_mode = HorizonMode::Fixed;
+    tick_t fixed_horizon = 1000;
+    tick_t max_horizon = 0;
+    SimEngine engine = SimEngine::Event;
+    bool histograms = false;        // quantili per task nel per_task (BatchConfig::collect_histograms)
+};
+
+struct CampaignShard {
+    std::size_t index = 0;
+    std::size_t count = 1;          // numero totale di shard
+    std::uint64_t first_run = 0;    // run_id della prima run dello shard
+    std::uint64_t runs = 0;
+};
+
+inline CampaignShard shard_of(const CampaignSpec& spec, std::size_t index, std::size_t n_shards) {
+    if (n_shards == 0 || index >= n_shards) {
+        throw std::invalid_argument("shard_of: shard index must be < number of shards");
+    }
+    const std::uint64_t base = spec.count / n_shards;
+    const std::uint64_t extra = spec.count % n_shards;
+
+    CampaignShard s;
+    s.index = index;
+    s.count = n_shards;
+    s.first_run = index * base + std::min<std::uint64_t>(index, extra);
+    s.runs = base + (index < extra ? 1 : 0);
+    return s;
+}
+
+inline std::filesystem::path shard_directory(const std::filesystem::path& out_dir, const CampaignShard& shard) {
+    return out_dir / ("shard-" + std::to_string(shard.index) + "-of-" + std::to_string(shard.count));
+}
+
+namespace campaign_detail {
+
+inline std::string trim(const std::string& s) {
+    const auto b = s.find_first_not_of(" \t\r");
+    if (b == std::string::npos) return {};
+    return s.substr(b, s.find_last_not_of(" \t\r") - b + 1);
+}
+
+template <typename T>
+T parse_number(const std::string& key, const std::string& value) {
+    T v{};
+    const auto res = std::from_chars(value.data(), value.data() + value.size(), v);
+    if (res.ec != std::errc() || res.ptr != value.data() + value.size()) {
+        throw std::invalid_argument("Campaign: invalid value for " + key + ": " + value);
+    }
+    return v;
+}
+
+inline SchedPolicy parse_policy(const std::string& name) {
+    for (SchedPolicy p : {SchedPolicy::FPP, SchedPolicy::DM, SchedPolicy::EDF, SchedPolicy::LLF}) {
+        if (name == policy_name(p)) return p;
+    }
+    throw std::invalid_argument("Campaign: unknown policy: " + name);
+}
+
+// run_id della riga CSV (primo campo).
+inline std::int64_t run_id_of(const std::string& line, const std::string& path) {
+    std::int64_t id = 0;
+    const auto res = std::from_chars(line.data(), line.data() + line.size(), id);
+    if (res.ec != std::errc() || res.ptr == line.data() + line.size() || *res.ptr != ',') {
+        throw std::runtime_error("Merge: row without run_id in " + path);
+    }
+    return id;
+}
+
+} // namespace campaign_detail
+
+// Formato: una coppia "chiave = valore" per riga, '#' per i commenti. Chiavi:
+// n_tasks, t_min, t_max, utilization, period_mode (uniform|divisors|log_uniform),
+// max_hyperperiod, utilization_mode (normalized|uunifast|uunifast_discard),
+// first_seed, count, policies (es. FPP,EDF), horizon_mode (fixed|hyperperiod),
+// fixed_horizon, max_horizon, engine (tick|event), histograms (on|off).
+inline CampaignSpec parse_campaign(std::istream& in) {
+    using namespace campaign_detail;
+    CampaignSpec spec;
+    std::string line;
+    int line_no = 0;
+
+    while (std::getline(in, line)) {
+        line_no++;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        const auto eq = line.find('=');
+        if (eq == std::string::npos) {
+            throw std::invalid_argument("Campaign: expected 'key = value' at line " + std::to_string(line_no));
+        }
+        const std::string key = trim(line.substr(0, eq));
+        const std::string value = trim(line.substr(eq + 1));
+        GeneratorConfig& g = spec.generator;
+
+        if (key == "n_tasks") g.n_tasks = parse_number<std::int32_t>(key, value);
+        else if (key == "t_min") g.Tmin = parse_number<tick_t>(key, value);
+        else if (key == "t_max") g.Tmax = parse_number<tick_t>(key, value);
+        else if (key == "utilization") g.utilization_target = parse_number<double>(key, value);
+        else if (key == "max_hyperperiod") g.max_hyperperiod = parse_number<tick_t>(key, value);
+        else if (key == "period_mode") {
+            if (value == "uniform") g.period_mode = PeriodMode::Uniform;
+            else if (value == "divisors") g.period_mode = PeriodMode::Divisors;
+            else if (value == "log_uniform") g.period_mode = PeriodMode::LogUniform;
+            else throw std::invalid_argument("Campaign: unknown period_mode: " + value);
+        } else if (key == "utilization_mode") {
+            if (value == "normalized") g.utilization_mode = UtilizationMode::Normalized;
+            else if (value == "uunifast") g.utilization_mode = UtilizationMode::UUniFast;
+            else if (value == "uunifast_discard") g.utilization_mode = UtilizationMode::UUniFastDiscard;
+            else throw std::invalid_argument("Campaign: unknown utilization_mode: " + value);
+        } else if (key == "first_seed") spec.first_seed = parse_number<std::uint32_t>(key, value);
+        else if (key == "count") spec.count = parse_number<std::uint64_t>(key, value);
+        else if (key == "policies") {
+            spec.policies.clear();
+            std::istringstream names(value);
+            std::string name;
+            while (std::getline(names, name, ',')) spec.policies.push_back(parse_policy(trim(name)));
+            if (spec.policies.empty()) throw std::invalid_argument("Campaign: empty policies");
+        } else if (key == "horizon_mode") {
+            if (value == "fixed") spec.horizon_mode = HorizonMode::Fixed;
+            else if (value == "hyperperiod") spec.horizon_mode = HorizonMode::Hyperperiod;
+            else throw std::invalid_argument("Campaign: unknown horizon_mode: " + value);
+        } else if (key == "fixed_horizon") spec.fixed_horizon = parse_number<tick_t>(key, value);
+        else if (key == "max_horizon") spec.max_horizon = parse_number<tick_t>(key, value);
+        else if (key == "engine") {
+            if (value == "tick") spec.engine = SimEngine::Tick;
+            else if (value == "event") spec.engine = SimEngine::Event;
+            else throw std::invalid_argument("Campaign: unknown engine: " + value);
+        } else if (key == "histograms") {
+            if (value == "on") spec.histograms = true;
+            else if (value == "off") spec.histograms = false;
+            else throw std::invalid_argument("Campaign: invalid value for histograms: " + value);
+        } else {
+            throw std::invalid_argument("Campaign: unknown key '" + key + "' at line " + std::to_string(line_no));
+        }
+    }
+    return spec;
+}
+
+inline CampaignSpec load_campaign(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Cannot open campaign file: " + path);
+    return parse_campaign(in);
+}
+
+// Forma canonica della campagna (tutte le chiavi, double nella forma più breve esatta), rileggibile
+// con parse_campaign: due campagne producono gli stessi risultati se e solo se coincide.
+inline std::string format_campaign(const CampaignSpec& spec) {
+    const GeneratorConfig& g = spec.generator;
+    char utilization[32];
+    const auto res = std::to_chars(utilization, utilization + sizeof(utilization), g.utilization_target);
+
+    std::ostringstream os;
+    os << "n_tasks = " << g.n_tasks << '\n'
+       << "t_min = " << g.Tmin << '\n'
+       << "t_max = " << g.Tmax << '\n'
+       << "utilization = " << std::string_view(utilization, res.ptr - utilization) << '\n'
+       << "period_mode = " << (g.period_mode == PeriodMode::Uniform ? "uniform"
+                              : g.period_mode == PeriodMode::Divisors ? "divisors" : "log_uniform") << '\n'
+       << "max_hyperperiod = " << g.max_hyperperiod << '\n'
+       << "utilization_mode = " << (g.utilization_mode == UtilizationMode::Normalized ? "normalized"
+                                   : g.utilization_mode == UtilizationMode::UUniFast ? "uunifast"
+                                   : "uunifast_discard") << '\n'
+       << "first_seed = " << spec.first_seed << '\n'
+       << "count = " << spec.count << '\n'
+       << "policies = ";
+    for (size_t i = 0; i < spec.policies.size(); ++i) os << (i > 0 ? "," : "") << policy_name(spec.policies[i]);
+    os << '\n'
+       << "horizon_mode = " << (spec.horizon_mode == HorizonMode::Fixed ? "fixed" : "hyperperiod") << '\n'
+       << "fixed_horizon = " << spec.fixed_horizon << '\n'
+       << "max_horizon = " << spec.max_horizon << '\n'
+       << "engine = " << (spec.engine == SimEngine::Tick ? "tick" : "event") << '\n'
+       << "histograms = " << (spec.histograms ? "on" : "off") << '\n';
+    return os.str();
+}
+
+namespace campaign_detail {
+
+// Manifest di uno shard completato: intervallo di run e campagna canonica.
+inline std::string shard_manifest(const CampaignSpec& spec, const CampaignShard& shard) {
+    return "rt-shard 1\nruns " + std::to_string(shard.first_run) + ' ' + std::to_string(shard.runs) +
+           '\n' + format_campaign(spec);
+}
+
+// Verifica il manifest di `dir`: falso se assente, errore se di un'altra campagna o shard.
+inline bool check_manifest(const std::filesystem::path& dir, const CampaignSpec& spec, const CampaignShard& shard) {
+    std::ifstream in(dir / "shard.done", std::ios::binary);
+    if (!in) return false;
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (text != shard_manifest(spec, shard)) {
+        throw std::runtime_error("Shard manifest does not match the campaign: " + dir.string() +
+                                 " (use a new output directory for a modified campaign)");
+    }
+    return true;
+}
+
+} // namespace campaign_detail
+
+// Esegue lo shard `index` di `n_shards`. `base` fornisce le opzioni non descritte dalla
+// campagna (worker, export, RTA, ...). Uno shard interrotto riprende dal journal; uno
+// shard già completato (manifest presente) non viene rieseguito. Un manifest o un journal
+// di una campagna diversa (file modificato dopo il primo lancio) è un errore.
+inline void run_shard(const CampaignSpec& spec,
+                      std::size_t index,
+                      std::size_t n_shards,
+                      const std::filesystem::path& out_dir,
+                      const BatchConfig& base = {}) {
+    const CampaignShard shard = shard_of(spec, index, n_shards);
+    const std::filesystem::path dir = shard_directory(out_dir, shard);
+    const std::filesystem::path done = dir / "shard.done";
+    const std::string summary = (dir / "summary.csv").string();
+    const std::string per_task = (dir / "per_task.csv").string();
+
+    if (campaign_detail::check_manifest(dir, spec, shard)) return;
+
+    std::filesystem::create_directories(dir);
+    // Senza journal lo shard riparte da zero: eventuali righe di un tentativo precedente
+    // (senza checkpoint) non devono essere duplicate.
+    if (!std::filesystem::exists(dir / "summary.journal")) {
+        for (const char* f : {"summary.csv", "per_task.csv", "rta.csv", "distributions.csv", "aggregates.csv"}) {
+            std::filesystem::remove(dir / f);
+        }
+    }
+
+    BatchConfig cfg = base;
+    cfg.policies = spec.policies;
+    cfg.horizon_mode = spec.horizon_mode;
+    cfg.fixed_horizon = spec.fixed_horizon;
+    cfg.max_horizon = spec.max_horizon;
+    cfg.engine = spec.engine;
+    cfg.collect_histograms = spec.histograms;
+    cfg.run_id_offset = static_cast<std::int64_t>(shard.first_run);
+    cfg.output_format = OutputFormat::Csv;
+    cfg.checkpoint = true;
+    cfg.journal_path.clear();
+    cfg.rta_csv_path.clear();
+    cfg.distributions_csv_path.clear();
+    cfg.aggregates_csv_path.clear();
+
+    if (shard.runs == 0) {
+        // Shard vuoto (più shard che run): solo gli header, per un merge uniforme.
+        CsvExporter(summary, per_task).close();
+    } else {
+        const SeedRangeSource source(spec.generator,
+                                     spec.first_seed + static_cast<std::uint32_t>(shard.first_run),
+                                     shard.runs);
+        std::string fingerprint = format_campaign(spec);
+        std::replace(fingerprint.begin(), fingerprint.end(), '\n', ';');
+        cfg.campaign_fingerprint = fingerprint;
+        BatchRunner::run_stream(source, cfg, summary, per_task);
+    }
+
+    std::ofstream manifest(done, std::ios::binary | std::ios::trunc);
+    manifest << campaign_detail::shard_manifest(spec, shard);
+    manifest.close();
+    if (manifest.fail()) throw std::runtime_error("Cannot write shard manifest: " + done.string());
+}
+
+// Fonde CSV con run_id nel primo campo, ciascuno ordinato per run_id, in `output`
+// (sovrascritto). Le righe di una run restano contigue e nell'ordine di origine; gli
+// header devono coincidere e un run_id presente in più input è un errore.
+inline std::uint64_t merge_csv_by_run_id(const std::vector<std::string>& inputs, const std::string& output) {
+    using campaign_detail::run_id_of;
+
+    struct Input {
+        std::ifstream in;
+        std::string path;
+        std::string line;
+        std::int64_t run_id = 0;
+        bool has_line = false;
+
+        void advance() {
+            const std::int64_t prev = has_line ? run_id : -1;
+            has_line = static_cast<bool>(std::getline(in, line)) && !line.empty();
+            if (!has_line) return;
+            run_id = run_id_of(line, path);
+            if (run_id < prev) throw std::runtime_error("Merge: rows not ordered by run_id in " + path);
+        }
+    };
+
+    std::vector<Input> files(inputs.size());
+    std::string header;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        Input& f = files[i];
+        f.path = inputs[i];
+        f.in.open(f.path, std::ios::binary);
+        if (!f.in) throw std::runtime_error("Cannot open shard output: " + f.path);
+
+        std::string h;
+        std::getline(f.in, h);
+        if (i == 0) header = h;
+        else if (h != header) throw std::runtime_error("Merge: different CSV header in " + f.path);
+        f.advance();
+    }
+
+    std::filesystem::remove(output);
+    BufferedFileWriter out(output, false);
+    out.buffer().append(header).push_back('\n');
+
+    std::uint64_t rows = 0;
+    for (;;) {
+        Input* next = nullptr;
+        for (auto& f : files) {
+            if (!f.has_line) continue;
+            if (next && f.run_id == next->run_id) {
+                throw std::runtime_error("Merge: run_id " + std::to_string(f.run_id) + " in both " +
+                                         next->path + " and " + f.path);
+            }
+            if (!next || f.run_id < next->run_id) next = &f;
+        }
+        if (!next) break;
+
+        const std::int64_t id = next->run_id;
+        while (next->has_line && next->run_id == id) {
+            out.buffer().append(next->line).push_back('\n');
+            out.maybe_flush();
+            rows++;
+            next->advance();
+        }
+    }
+
+    out.close();
+    return rows;
+}
+
+// Fonde gli shard completati di una campagna nei CSV canonici di `out_dir`
+// (rta.csv solo se prodotto dagli shard).
+inline void merge_shards(const CampaignSpec& spec, std::size_t n_shards, const std::filesystem::path& out_dir) {
+    std::vector<std::string> summaries, per_tasks, rtas;
+
+    for (std::size_t i = 0; i < n_shards; ++i) {
+        const CampaignShard shard = shard_of(spec, i, n_shards);
+        const std::filesystem::path dir = shard_directory(out_dir, shard);
+
+        if (!campaign_detail::check_manifest(dir, spec, shard)) {
+            throw std::runtime_error("Shard " + std::to_string(i) + "/" + std::to_string(n_shards) +
+                                     " not completed: " + dir.string());
+        }
+
+        summaries.push_back((dir / "summary.csv").string());
+        per_tasks.push_back((dir / "per_task.csv").string());
+        if (std::filesystem::exists(dir / "rta.csv")) rtas.push_back((dir / "rta.csv").string());
+    }
+    if (!rtas.empty() && rtas.size() != n_shards) {
+        throw std::runtime_error("Merge: rta.csv missing in some shards");
+    }
+
+    merge_csv_by_run_id(summaries, (out_dir / "summary.csv").string());
+    merge_csv_by_run_id(per_tasks, (out_dir / "per_task.csv").string());
+    if (!rtas.empty()) merge_csv_by_run_id(rtas, (out_dir / "rta.csv").string());
+}
+
+} // namespace rt
@@ -0,0 +1,82 @@
+// counter_rng.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Generatore pseudo-casuale counter-based: il valore n-esimo di uno stream è una funzione
+// pura di (seed, stream, n), calcolata con il finalizzatore di SplitMix64.
+// - accesso casuale: nessuno stato da far avanzare, stream indipendenti per task set
+// - risultati riproducibili indipendentemente da quanti thread generano e in che ordine
+// Soddisfa UniformRandomBitGenerator (utilizzabile con le distribuzioni della libreria standard).
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace rt {
+
+class CounterRng {
+public:
+    using result_type = std::uint64_t;
+
+    CounterRng(std::uint64_t seed, std::uint64_t stream)
+        : key_(mix64(seed ^ mix64(stream + golden))) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    // Valore n-esimo dello stream (non modifica il contatore).
+    result_type at(std::uint64_t n) const {
+        return mix64(key_ + (n + 1) * golden);
+    }
+
+    result_type operator()() { return at(counter_++); }
+
+    void seek(std::uint64_t n) { counter_ = n; }
+
+    // Reale uniforme in [0, 1) dai 53 bit alti.
+    static double to_unit(result_type x) {
+        return static_cast<double>(x >> 11) * 0x1.0p-53;
+    }
+
+    // Intero in [0, n): parte alta del prodotto a 128 bit (bias trascurabile per n << 2^64).
+    static std::uint64_t to_bounded(result_type x, std::uint64_t n) {
+        return mul_high(x, n);
+    }
+
+    // 64 bit alti di a * b: intrinseco dove disponibile, altrimenti metà a 32 bit
+    // (stesso risultato su ogni compilatore).
+    static std::uint64_t mul_high(std::uint64_t a, std::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef unsigned __int128 u128;
+        return static_cast<std::uint64_t>((static_cast<u128>(a) * b) >> 64);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        return __umulh(a, b);
+#else
+        const std::uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+        const std::uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+        const std::uint64_t lo_lo = a_lo * b_lo;
+        const std::uint64_t hi_lo = a_hi * b_lo;
+        const std::uint64_t lo_hi = a_lo * b_hi;
+        const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+        return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+    }
+
+private:
+    static constexpr std::uint64_t golden = 0x9E3779B97F4A7C15ULL;
+
+    static std::uint64_t mix64(std::uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t key_;
+    std::uint64_t counter_ = 0;
+};
+
+} // namespace rt
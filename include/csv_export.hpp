@@ -4,6 +4,9 @@
 // Funzioni di esportazione CSV:
 // - summary per simulazione (una riga per task set)
 // - per-task metrics (una riga per task per simulazione)
+// CsvExporter: stesso output delle funzioni append_*, ma con file aperti una sola volta,
+// formattazione via std::to_chars in un buffer e scritture a blocchi grandi
+// (opzionalmente delegate a un thread writer in background).
 
 #pragma once
 
@@ -12,12 +15,59 @@
 #include <vector>
 #include <stdexcept>
 #include <iomanip>
+#include <charconv>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <cstdint>
 
 #include "task.hpp"
 #include "metrics.hpp"
 
 namespace rt {
 
+inline const char* summary_csv_header() {
+    return "run_id,policy,n_tasks,horizon,busy_ticks,utilization,deadline_miss,unfinished_jobs,"
+           "peak_live_jobs,peak_job_bytes,extrapolated_ticks,context_switches,preemptions,switch_overhead_ticks,"
+           "cores,migrations,core_util_min,core_util_max,critical_scaling,breakdown_utilization,"
+           "stop_tick,stop_reason";
+}
+
+inline const char* per_task_csv_header() {
+    return "run_id,policy,task_index,task_id,priority,period,deadline,wcet,offset,"
+           "jobs_released,jobs_completed,deadline_miss,unfinished,rt_avg,rt_max,late_avg,late_max,"
+           "rt_p50,rt_p90,rt_p99,late_p99,start_p99,start_jitter,context_switches,preemptions,"
+           "core,migrations";
+}
+
+inline const char* distribution_csv_header() {
+    return "policy,jobs_completed,deadline_miss,rt_avg,rt_p50,rt_p90,rt_p99,rt_p999,rt_max,"
+           "late_p99,late_max,start_p99,start_max";
+}
+
+inline const char* rta_csv_header() {
+    return "run_id,task_index,task_id,priority,period,deadline,wcet,wcrt,schedulable";
+}
+
+// Formattazione veloce per i writer bufferizzati (stesso testo di operator<<).
+template <typename Int>
+void append_int(std::string& out, Int v) {
+    char buf[24];
+    const auto res = std::to_chars(buf, buf + sizeof(buf), v);
+    out.append(buf, res.ptr);
+}
+
+// Equivalente a `std::fixed << std::setprecision(6)`.
+inline void append_fixed6(std::string& out, double v) {
+    char buf[64];
+    const auto res = std::to_chars(buf, buf + sizeof(buf), v, std::chars_format::fixed, 6);
+    if (res.ec != std::errc{}) throw std::runtime_error("CSV: cannot format value");
+    out.append(buf, res.ptr);
+}
+
 inline void write_csv_header_if_needed(std::ofstream& out, const std::string& header) {
     // Assumiamo che se il file è vuoto (tellp == 0) dobbiamo scrivere l'header.
     if (out.tellp() == 0) {
@@ -34,8 +84,7 @@ inline void append_summary_csv(const std::string& path,
     std::ofstream out(path, std::ios::app);
     if (!out) throw std::runtime_error("Cannot open CSV file: " + path);
 
-    write_csv_header_if_needed(out,
-        "run_id,policy,n_tasks,horizon,busy_ticks,utilization,deadline_miss,unfinished_jobs");
+    write_csv_header_if_needed(out, summary_csv_header());
 
     out << run_id << ","
         << policy << ","
@@ -44,7 +93,21 @@ inline void append_summary_csv(const std::string& path,
         << m.busy_ticks << ","
         << std::fixed << std::setprecision(6) << m.utilization() << ","
         << m.deadline_miss_total << ","
-        << m.unfinished_total
+        << m.unfinished_total << ","
+        << m.peak_live_jobs << ","
+        << m.peak_job_bytes << ","
+        << m.extrapolated_ticks << ","
+        << m.context_switches << ","
+        << m.preemptions_total << ","
+        << m.switch_overhead_ticks << ","
+        << m.cores() << ","
+        << m.migrations << ","
+        << std::fixed << std::setprecision(6) << m.core_utilization_min() << ","
+        << std::fixed << std::setprecision(6) << m.core_utilization_max() << ","
+        << std::fixed << std::setprecision(6) << m.critical_scaling << ","
+        << std::fixed << std::setprecision(6) << m.breakdown_utilization << ","
+        << m.stop_tick << ","
+        << stop_reason_name(m.stop_reason)
         << "\n";
 }
 
@@ -57,9 +120,7 @@ inline void append_per_task_csv(const std::string& path,
     std::ofstream out(path, std::ios::app);
     if (!out) throw std::runtime_error("Cannot open CSV file: " + path);
 
-    write_csv_header_if_needed(out,
-        "run_id,policy,task_index,task_id,priority,period,deadline,wcet,offset,"
-        "jobs_released,jobs_completed,deadline_miss,unfinished,rt_avg,rt_max,late_avg,late_max");
+    write_csv_header_if_needed(out, per_task_csv_header());
 
     for (size_t i = 0; i < tasks.size(); ++i) {
         const auto& t = tasks[i];
@@ -81,9 +142,298 @@ inline void append_per_task_csv(const std::string& path,
             << std::fixed << std::setprecision(6) << tm.avg_response_time() << ","
             << tm.rt_max << ","
             << std::fixed << std::setprecision(6) << tm.avg_lateness() << ","
-            << tm.lateness_max
+            << tm.lateness_max << ","
+            << tm.rt_quantile(0.50) << ","
+            << tm.rt_quantile(0.90) << ","
+            << tm.rt_quantile(0.99) << ","
+            << tm.late_quantile(0.99) << ","
+            << tm.start_quantile(0.99) << ","
+            << tm.start_jitter() << ","
+            << tm.context_switches << ","
+            << tm.preemptions << ","
+            << tm.core << ","
+            << tm.migrations
             << "\n";
     }
 }
 
-} // namespace rt
\ No newline at end of file
+// File in append con buffer: i dati vengono scritti su disco a blocchi di almeno
+// `block_size` byte, direttamente o tramite un thread writer dedicato.
+class BufferedFileWriter {
+public:
+    static constexpr std::size_t default_block_size = std::size_t{1} << 20; // 1 MiB
+
+    BufferedFileWriter(const std::string& path, bool background, std::size_t block_size = default_block_size)
+        : path_(path), block_size_(block_size)
+    {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(path_, ec);
+        was_empty_ = ec || size == 0;
+        offset_ = ec ? 0 : size;
+
+        out_.open(path_, std::ios::binary | std::ios::app);
+        if (!out_) throw std::runtime_error("Cannot open CSV file: " + path_);
+
+        buffer_.reserve(block_size_ + block_size_ / 4);
+        if (background) {
+            writer_ = std::thread([this] { writer_loop(); });
+        }
+    }
+
+    BufferedFileWriter(const BufferedFileWriter&) = delete;
+    BufferedFileWriter& operator=(const BufferedFileWriter&) = delete;
+
+    ~BufferedFileWriter() {
+        try {
+            close();
+        } catch (...) {
+            // Errori di scrittura nel distruttore non possono essere propagati.
+        }
+    }
+
+    // Vero se il file non esisteva o era vuoto all'apertura (serve l'header).
+    bool was_empty() const { return was_empty_; }
+
+    std::string& buffer() { return buffer_; }
+
+    // Da chiamare dopo ogni riga: svuota il buffer quando supera la dimensione di blocco.
+    void maybe_flush() {
+        if (buffer_.size() >= block_size_) flush();
+    }
+
+    void flush() {
+        if (buffer_.empty()) return;
+        offset_ += buffer_.size();
+
+        if (!writer_.joinable()) {
+            write_block(buffer_);
+            buffer_.clear();
+            return;
+        }
+
+        std::string block;
+        block.reserve(block_size_ + block_size_ / 4);
+        block.swap(buffer_);
+
+        std::unique_lock<std::mutex> lock(m_);
+        // Al massimo due blocchi in coda: il produttore non accumula memoria senza limite.
+        cv_.wait(lock, [&] { return pending_.size() < 2 || error_; });
+        if (error_) std::rethrow_exception(error_);
+        pending_.push_back(std::move(block));
+        cv_.notify_all();
+    }
+
+    // Svuota il buffer e attende che tutto sia stato consegnato al sistema operativo:
+    // al ritorno il file contiene esattamente offset() byte.
+    void sync() {
+        flush();
+        if (writer_.joinable()) {
+            std::unique_lock<std::mutex> lock(m_);
+            cv_.wait(lock, [&] { return (pending_.empty() && !writing_) || error_; });
+            if (error_) std::rethrow_exception(error_);
+        }
+        out_.flush();
+        if (!out_) throw std::runtime_error("Error writing CSV file: " + path_);
+    }
+
+    // Dimensione del file a scritture completate (buffer escluso).
+    std::uint64_t offset() const { return offset_; }
+
+    void close() {
+        if (closed_) return;
+        closed_ = true;
+
+        std::exception_ptr err;
+        try {
+            flush();
+        } catch (...) {
+            err = std::current_exception();
+        }
+
+        if (writer_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(m_);
+                stop_ = true;
+                cv_.notify_all();
+            }
+            writer_.join();
+            if (!err) err = error_;
+        }
+
+        out_.close();
+        if (err) std::rethrow_exception(err);
+        if (out_.fail()) throw std::runtime_error("Error closing CSV file: " + path_);
+    }
+
+private:
+    void write_block(const std::string& block) {
+        out_.write(block.data(), static_cast<std::streamsize>(block.size()));
+        if (!out_) throw std::runtime_error("Error writing CSV file: " + path_);
+    }
+
+    void writer_loop() {
+        for (;;) {
+            std::string block;
+            {
+                std::unique_lock<std::mutex> lock(m_);
+                cv_.wait(lock, [&] { return !pending_.empty() || stop_; });
+                if (pending_.empty()) return;
+                block = std::move(pending_.front());
+                pending_.pop_front();
+                writing_ = true;
+                cv_.notify_all();
+            }
+            try {
+                write_block(block);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m_);
+                error_ = std::current_exception();
+                writing_ = false;
+                cv_.notify_all();
+                return;
+            }
+            std::lock_guard<std::mutex> lock(m_);
+            writing_ = false;
+            cv_.notify_all();
+        }
+    }
+
+    std::string path_;
+    std::size_t block_size_;
+    bool was_empty_ = true;
+    bool closed_ = false;
+    std::uint64_t offset_ = 0;
+
+    std::ofstream out_;
+    std::string buffer_;
+
+    std::thread writer_;
+    std::mutex m_;
+    std::condition_variable cv_;
+    std::deque<std::string> pending_;
+    bool writing_ = false;
+    bool stop_ = false;
+    std::exception_ptr error_;
+};
+
+// Exporter persistente per una campagna batch: summary e per-task restano aperti
+// per tutta la durata e producono file identici byte per byte a append_*_csv.
+class CsvExporter {
+public:
+    CsvExporter(const std::string& summary_path,
+                const std::string& per_task_path,
+                bool background_writer = false)
+        : summary_(summary_path, background_writer),
+          per_task_(per_task_path, background_writer)
+    {
+        if (summary_.was_empty()) {
+            summary_.buffer().append(summary_csv_header()).push_back('\n');
+        }
+        if (per_task_.was_empty()) {
+            per_task_.buffer().append(per_task_csv_header()).push_back('\n');
+        }
+    }
+
+    void write_run(std::int64_t run_id,
+                   const std::vector<Task>& tasks,
+                   const SimulationMetrics& m,
+                   const std::string& policy = "FPP")
+    {
+        write_summary(run_id, tasks, m, policy);
+        write_per_task(run_id, tasks, m, policy);
+    }
+
+    void write_summary(std::int64_t run_id,
+                       const std::vector<Task>& tasks,
+                       const SimulationMetrics& m,
+                       const std::string& policy = "FPP")
+    {
+        std::string& out = summary_.buffer();
+        append_int(out, run_id);                 out.push_back(',');
+        out.append(policy);                   out.push_back(',');
+        append_int(out, static_cast<std::uint64_t>(tasks.size())); out.push_back(',');
+        append_int(out, m.horizon);              out.push_back(',');
+        append_int(out, m.busy_ticks);           out.push_back(',');
+        append_fixed6(out, m.utilization());     out.push_back(',');
+        append_int(out, m.deadline_miss_total);  out.push_back(',');
+        append_int(out, m.unfinished_total);     out.push_back(',');
+        append_int(out, m.peak_live_jobs);       out.push_back(',');
+        append_int(out, m.peak_job_bytes);       out.push_back(',');
+        append_int(out, m.extrapolated_ticks);   out.push_back(',');
+        append_int(out, m.context_switches);     out.push_back(',');
+        append_int(out, m.preemptions_total);    out.push_back(',');
+        append_int(out, m.switch_overhead_ticks); out.push_back(',');
+        append_int(out, static_cast<std::uint64_t>(m.cores())); out.push_back(',');
+        append_int(out, m.migrations);           out.push_back(',');
+        append_fixed6(out, m.core_utilization_min()); out.push_back(',');
+        append_fixed6(out, m.core_utilization_max()); out.push_back(',');
+        append_fixed6(out, m.critical_scaling);  out.push_back(',');
+        append_fixed6(out, m.breakdown_utilization); out.push_back(',');
+        append_int(out, m.stop_tick);            out.push_back(',');
+        out.append(stop_reason_name(m.stop_reason));
+        out.push_back('\n');
+        summary_.maybe_flush();
+    }
+
+    void write_per_task(std::int64_t run_id,
+                        const std::vector<Task>& tasks,
+                        const SimulationMetrics& m,
+                        const std::string& policy = "FPP")
+    {
+        std::string& out = per_task_.buffer();
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            const auto& t = tasks[i];
+            const auto& tm = m.per_task[i];
+
+            append_int(out, run_id);                 out.push_back(',');
+            out.append(policy);                   out.push_back(',');
+            append_int(out, static_cast<std::uint64_t>(i)); out.push_back(',');
+            append_int(out, t.id);                   out.push_back(',');
+            append_int(out, t.priority);             out.push_back(',');
+            append_int(out, t.period);               out.push_back(',');
+            append_int(out, t.deadline);             out.push_back(',');
+            append_int(out, t.wcet);                 out.push_back(',');
+            append_int(out, t.offset);               out.push_back(',');
+            append_int(out, tm.jobs_released);       out.push_back(',');
+            append_int(out, tm.jobs_completed);      out.push_back(',');
+            append_int(out, tm.deadline_miss);       out.push_back(',');
+            append_int(out, tm.unfinished);          out.push_back(',');
+            append_fixed6(out, tm.avg_response_time()); out.push_back(',');
+            append_int(out, tm.rt_max);              out.push_back(',');
+            append_fixed6(out, tm.avg_lateness());   out.push_back(',');
+            append_int(out, tm.lateness_max);        out.push_back(',');
+            append_int(out, tm.rt_quantile(0.50)); out.push_back(',');
+            append_int(out, tm.rt_quantile(0.90)); out.push_back(',');
+            append_int(out, tm.rt_quantile(0.99)); out.push_back(',');
+            append_int(out, tm.late_quantile(0.99)); out.push_back(',');
+            append_int(out, tm.start_quantile(0.99)); out.push_back(',');
+            append_int(out, tm.start_jitter());      out.push_back(',');
+            append_int(out, tm.context_switches);    out.push_back(',');
+            append_int(out, tm.preemptions);         out.push_back(',');
+            append_int(out, tm.core);                out.push_back(',');
+            append_int(out, tm.migrations);
+            out.push_back('\n');
+        }
+        per_task_.maybe_flush();
+    }
+
+    void flush() {
+        summary_.flush();
+        per_task_.flush();
+    }
+
+    BufferedFileWriter& summary() { return summary_; }
+    BufferedFileWriter& per_task() { return per_task_; }
+
+    // Svuota i buffer e chiude i file, propagando eventuali errori di scrittura.
+    void close() {
+        summary_.close();
+        per_task_.close();
+    }
+
+private:
+    BufferedFileWriter summary_;
+    BufferedFileWriter per_task_;
+};
+
+} // namespace rt
@@ -0,0 +1,130 @@
+// histogram.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Istogramma log-lineare di valori in tick (response time, lateness, ritardo di avvio):
+// quantili approssimati senza memorizzare i singoli job.
+// - valori 0..31 esatti, poi 16 sotto-bucket per ogni potenza di 2 da 32 in su (errore relativo <= 1/16)
+// - memoria limitata: i bucket crescono fino al valore massimo visto (al più 960 contatori)
+// - min/max esatti; merge per somma dei contatori (istogrammi di run, task o politiche diverse)
+// - stato salvabile e ripristinabile come testo (checkpoint delle campagne batch)
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <bit>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <iostream>
+#include <stdexcept>
+
+#include "task.hpp"
+
+namespace rt {
+
+class LogHistogram {
+public:
+    static constexpr int sub_bits = 4;
+    static constexpr tick_t sub_buckets = tick_t{1} << sub_bits;
+    static constexpr std::size_t max_buckets = (64 - sub_bits) * sub_buckets;
+
+    // Registra un valore (i negativi contano come 0).
+    void record(tick_t v) {
+        v = std::max<tick_t>(v, 0);
+        const std::size_t b = bucket_of(v);
+        if (b >= counts_.size()) [[unlikely]] grow(b);
+        counts_[b]++;
+        min_ = std::min(min_, v);
+        max_ = std::max(max_, v);
+        count_++;
+    }
+
+    std::int64_t count() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    tick_t min() const { return count_ > 0 ? min_ : 0; }
+    tick_t max() const { return max_; }
+
+    // Quantile q in [0, 1] (nearest rank): limite superiore del bucket che contiene il
+    // rank, mai oltre il massimo esatto. 0 se l'istogramma è vuoto.
+    tick_t quantile(double q) const {
+        if (count_ == 0) return 0;
+        q = std::clamp(q, 0.0, 1.0);
+        const auto rank = std::max<std::int64_t>(
+            1, static_cast<std::int64_t>(std::ceil(q * static_cast<double>(count_))));
+
+        std::int64_t seen = 0;
+        for (std::size_t b = 0; b < counts_.size(); ++b) {
+            seen += counts_[b];
+            if (seen >= rank) return std::clamp(bucket_upper(b), min_, max_);
+        }
+        return max_;
+    }
+
+    void merge(const LogHistogram& other) {
+        if (other.count_ == 0) return;
+        if (other.counts_.size() > counts_.size()) counts_.resize(other.counts_.size(), 0);
+        for (std::size_t b = 0; b < other.counts_.size(); ++b) counts_[b] += other.counts_[b];
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        count_ += other.count_;
+    }
+
+    // I valori registrati da `before` in poi si ripetono altre `times` volte
+    // (estrapolazione dello stato stazionario): min e max non cambiano.
+    void repeat_since(const LogHistogram& before, std::int64_t times) {
+        for (std::size_t b = 0; b < counts_.size(); ++b) {
+            const std::int64_t prev = (b < before.counts_.size()) ? before.counts_[b] : 0;
+            counts_[b] += times * (counts_[b] - prev);
+        }
+        count_ += times * (count_ - before.count_);
+    }
+
+    std::size_t bytes() const { return counts_.capacity() * sizeof(std::int64_t); }
+
+    // Stato completo come sequenza di interi separati da spazi (vedi batch_journal.hpp).
+    void save(std::ostream& os) const {
+        os << count_ << ' ' << min_ << ' ' << max_ << ' ' << counts_.size();
+        for (std::int64_t c : counts_) os << ' ' << c;
+    }
+
+    void load(std::istream& is) {
+        std::size_t n = 0;
+        is >> count_ >> min_ >> max_ >> n;
+        if (!is || n > max_buckets) throw std::runtime_error("LogHistogram: invalid saved state");
+        counts_.assign(n, 0);
+        for (auto& c : counts_) is >> c;
+        if (!is) throw std::runtime_error("LogHistogram: invalid saved state");
+    }
+
+    // Senza salti: per v < 2 * sub_buckets lo shift è 0 e il bucket è v stesso.
+    static std::size_t bucket_of(tick_t v) {
+        const int shift = std::max(static_cast<int>(std::bit_width(static_cast<std::uint64_t>(v))) - (sub_bits + 1), 0);
+        return static_cast<std::size_t>(shift) * sub_buckets + static_cast<std::size_t>(v >> shift);
+    }
+
+    // Valore massimo rappresentato dal bucket b.
+    static tick_t bucket_upper(std::size_t b) {
+        if (b < 2 * static_cast<std::size_t>(sub_buckets)) return static_cast<tick_t>(b);
+        const int shift = static_cast<int>(b / sub_buckets) - 1;
+        const auto mantissa = static_cast<std::uint64_t>(b % sub_buckets + sub_buckets);
+        return static_cast<tick_t>(((mantissa + 1) << shift) - 1);
+    }
+
+private:
+    // Crescita per ottave intere e almeno del 50%: poche riallocazioni anche quando il
+    // massimo cresce gradualmente, poca memoria per i task con valori piccoli.
+    void grow(std::size_t b) {
+        const std::size_t octave = static_cast<std::size_t>(sub_buckets);
+        const std::size_t need = (b / octave + 1) * octave;
+        counts_.resize(std::min(max_buckets, std::max(need, counts_.size() + counts_.size() / 2)), 0);
+    }
+
+    std::vector<std::int64_t> counts_;
+    std::int64_t count_ = 0;
+    tick_t min_ = std::numeric_limits<tick_t>::max();
+    tick_t max_ = 0;
+};
+
+} // namespace rt
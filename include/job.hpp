@@ -3,6 +3,7 @@
 //
 // Rappresentazione di un job (istanza) rilasciato da un task periodico.
 // Include campi temporali e metodi di esecuzione per simulazione tick-based.
+// Layout compatto: start/finish usano il valore sentinella `no_tick` invece di std::optional.
 
 #pragma once
 
@@ -15,6 +16,9 @@
 
 namespace rt {
 
+// Valore sentinella per istanti non ancora avvenuti (start/finish).
+inline constexpr tick_t no_tick = -1;
+
 struct Job {
     id_t task_id = 0;                // identificatore logico (come da input)
     std::int32_t task_index = 0;     // indice interno in tasks_ (robusto)
@@ -24,8 +28,8 @@ struct Job {
     tick_t abs_deadline = 0;
     tick_t remaining_time = 0;
 
-    std::optional<tick_t> start_time;
-    std::optional<tick_t> finish_time;
+    tick_t start_time = no_tick;
+    tick_t finish_time = no_tick;
 
     static Job from_task(const Task& task, std::int32_t task_index, tick_t release_t, std::int32_t index) {
         task.validate();
@@ -43,6 +47,9 @@ struct Job {
 
     bool is_completed() const { return remaining_time == 0; }
 
+    bool has_started() const { return start_time != no_tick; }
+    bool is_finished() const { return finish_time != no_tick; }
+
     bool is_ready(tick_t now) const {
         return (now >= release_time) && (remaining_time > 0);
     }
@@ -50,7 +57,7 @@ struct Job {
     void execute_one_tick(tick_t now) {
         if (!is_ready(now)) throw std::logic_error("execute_one_tick called on non-ready job");
 
-        if (!start_time.has_value()) start_time = now;
+        if (!has_started()) start_time = now;
 
         remaining_time -= 1;
         if (remaining_time < 0) throw std::logic_error("remaining_time became negative");
@@ -60,9 +67,23 @@ struct Job {
         }
     }
 
+    // Esegue il job per `ticks` tick consecutivi a partire da `now` (motore a eventi).
+    // Equivale a `ticks` chiamate a execute_one_tick(now), ..., execute_one_tick(now + ticks - 1).
+    void execute_for(tick_t now, tick_t ticks) {
+        if (!is_ready(now)) throw std::logic_error("execute_for called on non-ready job");
+        if (ticks <= 0 || ticks > remaining_time) throw std::logic_error("execute_for: invalid tick count");
+
+        if (!has_started()) start_time = now;
+
+        remaining_time -= ticks;
+        if (remaining_time == 0) {
+            finish_time = now + ticks; // completa a fine dell'ultimo tick
+        }
+    }
+
     std::optional<tick_t> response_time() const {
-        if (!finish_time.has_value()) return std::nullopt;
-        return *finish_time - release_time;
+        if (!is_finished()) return std::nullopt;
+        return finish_time - release_time;
     }
 
     std::string to_string() const {
@@ -72,8 +93,8 @@ struct Job {
                ", r=" + std::to_string(release_time) +
                ", dl=" + std::to_string(abs_deadline) +
                ", rem=" + std::to_string(remaining_time) +
-               ", start=" + (start_time ? std::to_string(*start_time) : "n/a") +
-               ", finish=" + (finish_time ? std::to_string(*finish_time) : "n/a") +
+               ", start=" + (has_started() ? std::to_string(start_time) : "n/a") +
+               ", finish=" + (is_finished() ? std::to_string(finish_time) : "n/a") +
                "}";
     }
 };
@@ -0,0 +1,174 @@
+// job_pool.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Pool di slot per i job di una simulazione.
+// Gli slot dei job completati vengono riciclati (free list LIFO, slot "caldi" in cache),
+// quindi la memoria è limitata dal numero massimo di job contemporaneamente vivi
+// invece che dal numero totale di job rilasciati nell'horizon.
+// Layout structure-of-arrays: i campi letti/scritti a ogni esecuzione (remaining, start,
+// finish) sono separati da quelli letti solo a rilascio/completamento; Job resta il tipo
+// pubblico, ricostruito con get(slot) quando serve l'intero job (metriche, debug).
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+
+#include "job.hpp"
+
+namespace rt {
+
+class JobPool {
+public:
+    void clear() {
+        task_id_.clear();
+        task_index_.clear();
+        job_index_.clear();
+        release_.clear();
+        deadline_.clear();
+        remaining_.clear();
+        start_.clear();
+        finish_.clear();
+        free_.clear();
+        live_ = 0;
+        peak_live_ = 0;
+    }
+
+    // Inserisce un job e restituisce lo slot assegnato.
+    std::size_t acquire(const Job& j) {
+        std::size_t slot;
+        if (!free_.empty()) {
+            slot = free_.back();
+            free_.pop_back();
+        } else {
+            slot = remaining_.size();
+            task_id_.emplace_back();
+            task_index_.emplace_back();
+            job_index_.emplace_back();
+            release_.emplace_back();
+            deadline_.emplace_back();
+            remaining_.emplace_back();
+            start_.emplace_back();
+            finish_.emplace_back();
+        }
+
+        task_id_[slot] = j.task_id;
+        task_index_[slot] = j.task_index;
+        job_index_[slot] = j.job_index;
+        release_[slot] = j.release_time;
+        deadline_[slot] = j.abs_deadline;
+        remaining_[slot] = j.remaining_time;
+        start_[slot] = j.start_time;
+        finish_[slot] = j.finish_time;
+
+        live_++;
+        peak_live_ = std::max(peak_live_, live_);
+        return slot;
+    }
+
+    // Restituisce lo slot al pool (il job deve essere già stato contabilizzato nelle metriche).
+    void release(std::size_t slot) {
+        free_.push_back(static_cast<std::uint32_t>(slot));
+        live_--;
+    }
+
+    // Copia del job nello slot.
+    Job get(std::size_t slot) const {
+        Job j;
+        j.task_id = task_id_[slot];
+        j.task_index = task_index_[slot];
+        j.job_index = job_index_[slot];
+        j.release_time = release_[slot];
+        j.abs_deadline = deadline_[slot];
+        j.remaining_time = remaining_[slot];
+        j.start_time = start_[slot];
+        j.finish_time = finish_[slot];
+        return j;
+    }
+
+    std::int32_t task_index(std::size_t slot) const { return task_index_[slot]; }
+    tick_t remaining(std::size_t slot) const { return remaining_[slot]; }
+    bool is_finished(std::size_t slot) const { return finish_[slot] != no_tick; }
+
+    // Stessa semantica di Job::execute_for sul job nello slot.
+    void execute_for(std::size_t slot, tick_t now, tick_t ticks) {
+        tick_t& rem = remaining_[slot];
+        if (ticks <= 0 || ticks > rem || now < release_[slot])
+            throw std::logic_error("JobPool::execute_for: invalid execution");
+
+        if (start_[slot] == no_tick) start_[slot] = now;
+
+        rem -= ticks;
+        if (rem == 0) {
+            finish_[slot] = now + ticks; // completa a fine dell'ultimo tick
+        }
+    }
+
+    void execute_one_tick(std::size_t slot, tick_t now) { execute_for(slot, now, 1); }
+
+    std::size_t live() const { return live_; }
+    std::size_t peak_live() const { return peak_live_; }
+
+    // Memoria allocata per gli slot e la free list (picco della run, le capacità non calano).
+    std::size_t allocated_bytes() const {
+        return task_id_.capacity() * sizeof(id_t) +
+               task_index_.capacity() * sizeof(std::int32_t) +
+               job_index_.capacity() * sizeof(std::int32_t) +
+               (release_.capacity() + deadline_.capacity() + remaining_.capacity() +
+                start_.capacity() + finish_.capacity()) * sizeof(tick_t) +
+               free_.capacity() * sizeof(std::uint32_t);
+    }
+
+    // allocated_bytes() di un pool nuovo che ha raggiunto `peak_live` job vivi e al più
+    // `peak_free` slot liberi: le capacità dipendono solo dalle dimensioni massime
+    // raggiunte (crescita di emplace_back/push_back), non dalla sequenza di job.
+    static std::size_t allocated_bytes_for(std::size_t peak_live, std::size_t peak_free) {
+        return grown_capacity<id_t>(peak_live) * sizeof(id_t) +
+               2 * grown_capacity<std::int32_t>(peak_live) * sizeof(std::int32_t) +
+               5 * grown_capacity<tick_t>(peak_live) * sizeof(tick_t) +
+               grown_capacity<std::uint32_t>(peak_free) * sizeof(std::uint32_t);
+    }
+
+    // Job ancora vivi (non completati) in ordine di rilascio.
+    std::vector<Job> live_jobs() const {
+        std::vector<Job> out;
+        for (std::size_t slot = 0; slot < remaining_.size(); ++slot) {
+            if (remaining_[slot] != 0) out.push_back(get(slot));
+        }
+        std::sort(out.begin(), out.end(), [](const Job& a, const Job& b) {
+            if (a.release_time != b.release_time) return a.release_time < b.release_time;
+            return a.task_index < b.task_index;
+        });
+        return out;
+    }
+
+private:
+    // Capacità di un vettore vuoto dopo `n` inserimenti in coda.
+    template <typename T>
+    static std::size_t grown_capacity(std::size_t n) {
+        std::vector<T> v;
+        for (std::size_t i = 0; i < n; ++i) v.emplace_back();
+        return v.capacity();
+    }
+
+    // Campi caldi (esecuzione)
+    std::vector<tick_t> remaining_;
+    std::vector<tick_t> start_;
+    std::vector<tick_t> finish_;
+
+    // Campi letti a rilascio/completamento
+    std::vector<tick_t> release_;
+    std::vector<tick_t> deadline_;
+    std::vector<std::int32_t> task_index_;
+    std::vector<std::int32_t> job_index_;
+    std::vector<id_t> task_id_;
+
+    std::vector<std::uint32_t> free_;
+    std::size_t live_ = 0;
+    std::size_t peak_live_ = 0;
+};
+
+} // namespace rt
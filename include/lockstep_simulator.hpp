@@ -0,0 +1,388 @@
+// lockstep_simulator.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Simulazione di molti task set piccoli in lockstep: un task set per lane, `lockstep_lanes`
+// lane avanzano insieme, ciascuna con il proprio tempo e il proprio horizon.
+// Per ogni task e lane lo stato è ridotto a:
+//   next_release, pending (job rilasciati e non completati), head_release, head_rem e
+//   head_start (rilascio, residuo e avvio del job più vecchio).
+// Basta perché, con tutte le politiche supportate, i job dello stesso task vengono
+// eseguiti in ordine FIFO: la selezione confronta solo i job in testa di ogni task.
+// Ogni iterazione fa avanzare ogni lane al suo prossimo evento (rilascio, completamento,
+// horizon), come il motore a eventi di BasicSimulator (con LLF di un tick alla volta):
+// le lane non si aspettano a vicenda. Una lane arrivata al suo horizon riceve subito il
+// task set successivo, così le lane restano piene fino agli ultimi task set.
+// Rilasci, selezione e avanzamento sono operazioni branchless su vettori di lane
+// (LaneVec, layout [task]{campo[lane]}). Con GCC/Clang LaneVec è un vector type nativo
+// largo un registro del target (AVX-512, AVX2, SSE/NEON); con altri compilatori è un
+// array con operatori elemento per elemento (fallback scalare). Serve compilare per
+// l'ISA giusta (es. -march=native, opzione CMake RT_NATIVE_ARCH).
+//
+// Le SimulationMetrics per lane coincidono con quelle di BasicSimulator<Policy> senza
+// istogrammi, stato stazionario, overhead di switch e condizioni di stop (le
+// opzioni non supportate qui), incluso peak_job_bytes (JobPool::allocated_bytes_for).
+// Conviene con task set piccoli (il costo per evento cresce con il numero di task,
+// vedi lockstep_max_tasks) e non con LLF, che avanza di un tick alla volta: BatchRunner
+// lo usa solo in questi casi (BatchConfig::lockstep).
+
+#pragma once
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+
+#include "task.hpp"
+#include "scheduler.hpp"
+#include "metrics.hpp"
+#include "job_pool.hpp"
+
+namespace rt {
+
+// Lane per blocco = lane int64 di un registro vettoriale del target: 8 con AVX-512,
+// 4 con AVX/AVX2, 2 altrimenti (SSE2/NEON o scalare).
+#if defined(__AVX512F__)
+inline constexpr std::size_t lockstep_lanes = 8;
+#elif defined(__AVX__)
+inline constexpr std::size_t lockstep_lanes = 4;
+#else
+inline constexpr std::size_t lockstep_lanes = 2;
+#endif
+
+// Task set fino a questo numero di task sono più veloci in lockstep che con il motore a
+// eventi di BasicSimulator (FPP, DM, EDF; vedi bench_suite, casi lockstep/): oltre, la
+// scansione di tutti i task per evento costa più della ready queue. 0 con 2 lane
+// (SSE2/NEON: confronti a 64 bit non vettoriali), dove il lockstep non conviene mai.
+inline constexpr std::size_t lockstep_max_tasks = lockstep_lanes >= 8 ? 16 : lockstep_lanes >= 4 ? 8 : 0;
+
+namespace lockstep_detail {
+
+#if defined(__GNUC__) || defined(__clang__)
+
+using LaneVec = tick_t __attribute__((vector_size(lockstep_lanes * sizeof(tick_t))));
+
+// Le maschere sono lane con tutti i bit a 1 (vero) o 0 (falso).
+inline LaneVec splat(tick_t x) { return LaneVec{} + x; }
+inline LaneVec lt(LaneVec a, LaneVec b) { return reinterpret_cast<LaneVec>(a < b); }
+inline LaneVec eq(LaneVec a, LaneVec b) { return reinterpret_cast<LaneVec>(a == b); }
+
+#else
+
+struct LaneVec {
+    std::array<tick_t, lockstep_lanes> v{};
+
+    tick_t& operator[](std::size_t l) { return v[l]; }
+    tick_t operator[](std::size_t l) const { return v[l]; }
+
+    template <typename Op>
+    friend LaneVec zip(const LaneVec& a, const LaneVec& b, Op op) {
+        LaneVec r;
+        for (std::size_t l = 0; l < lockstep_lanes; ++l) r.v[l] = op(a.v[l], b.v[l]);
+        return r;
+    }
+
+    friend LaneVec operator+(const LaneVec& a, const LaneVec& b) { return zip(a, b, [](tick_t x, tick_t y) { return x + y; }); }
+    friend LaneVec operator-(const LaneVec& a, const LaneVec& b) { return zip(a, b, [](tick_t x, tick_t y) { return x - y; }); }
+    friend LaneVec operator&(const LaneVec& a, const LaneVec& b) { return zip(a, b, [](tick_t x, tick_t y) { return x & y; }); }
+    friend LaneVec operator|(const LaneVec& a, const LaneVec& b) { return zip(a, b, [](tick_t x, tick_t y) { return x | y; }); }
+    friend LaneVec operator~(const LaneVec& a) { return zip(a, a, [](tick_t x, tick_t) { return ~x; }); }
+    LaneVec& operator+=(const LaneVec& b) { return *this = *this + b; }
+    LaneVec& operator-=(const LaneVec& b) { return *this = *this - b; }
+};
+
+inline LaneVec splat(tick_t x) {
+    LaneVec r;
+    r.v.fill(x);
+    return r;
+}
+inline LaneVec lt(const LaneVec& a, const LaneVec& b) { return zip(a, b, [](tick_t x, tick_t y) -> tick_t { return x < y ? -1 : 0; }); }
+inline LaneVec eq(const LaneVec& a, const LaneVec& b) { return zip(a, b, [](tick_t x, tick_t y) -> tick_t { return x == y ? -1 : 0; }); }
+
+#endif
+
+inline LaneVec select(LaneVec m, LaneVec a, LaneVec b) { return (m & a) | (~m & b); }
+inline LaneVec vmin(LaneVec a, LaneVec b) { return select(lt(a, b), a, b); }
+inline LaneVec vmax(LaneVec a, LaneVec b) { return select(lt(b, a), a, b); }
+
+} // namespace lockstep_detail
+
+template <typename Policy = PolicyFPP>
+class LockstepSimulator {
+public:
+    static constexpr std::size_t W = lockstep_lanes;
+
+    LockstepSimulator(std::vector<std::vector<Task>> tasksets, tick_t horizon)
+        : LockstepSimulator(std::move(tasksets), std::vector<tick_t>()) {
+        horizons_.assign(tasksets_.size(), horizon);
+    }
+
+    // Un horizon per task set.
+    LockstepSimulator(std::vector<std::vector<Task>> tasksets, std::vector<tick_t> horizons)
+        : tasksets_(std::move(tasksets)), horizons_(std::move(horizons))
+    {
+        if (!horizons_.empty() && horizons_.size() != tasksets_.size()) {
+            throw std::invalid_argument("LockstepSimulator: one horizon per task set is required");
+        }
+        for (auto& ts : tasksets_) {
+            for (auto& t : ts) t.validate();
+            max_tasks_ = std::max(max_tasks_, ts.size());
+        }
+    }
+
+    void run() {
+        using namespace lockstep_detail;
+
+        const std::size_t n = max_tasks_;
+        metrics_.assign(tasksets_.size(), {});
+        tl_.assign(n, {});
+
+        const LaneVec zero = splat(0);
+        const LaneVec none = splat(-1);
+        const LaneVec inf = splat(never);
+
+        lanes_ = {};
+        next_set_ = 0;
+        for (std::size_t l = 0; l < W; ++l) load_lane(l);
+
+        for (;;) {
+            // Lane arrivate all'horizon: metriche e task set successivo
+            bool active = false;
+            for (std::size_t l = 0; l < W; ++l) {
+                while (lanes_.set[l] >= 0 && lanes_.now[l] >= lanes_.horizon[l]) {
+                    store_lane(l);
+                    load_lane(l);
+                }
+                active = active || lanes_.set[l] >= 0;
+            }
+            if (!active) break;
+
+            LaneState& ls = lanes_;
+            const LaneVec now = ls.now;
+
+            // 1) Rilasci in `now` e prossimo rilascio per lane
+            LaneVec live = zero;
+            LaneVec next_rel = inf;
+            for (std::size_t i = 0; i < n; ++i) {
+                TaskLanes& s = tl_[i];
+                const LaneVec rel = eq(s.next_release, now);
+                const LaneVec first_pending = rel & eq(s.pending, zero);
+                s.head_rem = select(first_pending, s.wcet, s.head_rem);
+                s.head_release = select(first_pending, now, s.head_release);
+                s.pending -= rel;
+                s.released -= rel;
+                s.next_release += rel & s.period;
+                live += s.pending;
+                next_rel = vmin(next_rel, s.next_release);
+            }
+            ls.live_peak = vmax(ls.live_peak, live);
+
+            // 2) Selezione: job in testa con chiave minima
+            LaneVec best1 = inf, best2 = inf, best3 = inf;
+            LaneVec best_task = none;
+            LaneVec run_rem = inf;
+            for (std::size_t i = 0; i < n; ++i) {
+                const TaskLanes& s = tl_[i];
+                const LaneVec k1 = primary_key(s, now);
+                const LaneVec k2 = secondary_key(s);
+                const LaneVec k3 = s.head_release;
+                const LaneVec better = lt(zero, s.pending) &
+                    (lt(k1, best1) | (eq(k1, best1) & (lt(k2, best2) | (eq(k2, best2) & lt(k3, best3)))));
+                best1 = select(better, k1, best1);
+                best2 = select(better, k2, best2);
+                best3 = select(better, k3, best3);
+                best_task = select(better, splat(static_cast<tick_t>(i)), best_task);
+                run_rem = select(better, s.head_rem, run_rem);
+            }
+
+            // 3) Passo di ogni lane: fino al suo prossimo evento (0 per le lane vuote)
+            LaneVec step = ls.horizon - now;
+            if constexpr (std::is_same_v<Policy, PolicyLLF>) {
+                step = vmin(step, splat(1));
+            } else {
+                step = vmin(step, vmin(run_rem, next_rel - now));
+            }
+
+            // 4) Esecuzione per `step` tick e completamenti (aggiornamenti mascherati per task)
+            const LaneVec finish = now + step;
+            const LaneVec running = ~eq(best_task, none);
+            const LaneVec switched = running & ~eq(best_task, ls.last_task);
+            const LaneVec preempting = switched & ~eq(ls.last_task, none);
+            ls.busy += running & step;
+
+            LaneVec any_done = zero;
+            LaneVec last_task = ls.last_task;
+            for (std::size_t i = 0; i < n; ++i) {
+                TaskLanes& s = tl_[i];
+                const LaneVec idx = splat(static_cast<tick_t>(i));
+                const LaneVec run = eq(best_task, idx);
+                s.switches -= run & switched;
+                s.preempted -= preempting & eq(ls.last_task, idx);
+                s.head_start = select(run & eq(s.head_start, none), now, s.head_start);
+
+                const LaneVec rem = s.head_rem - (run & step);
+                const LaneVec done = run & eq(rem, zero);
+
+                const LaneVec rt = finish - s.head_release;
+                const LaneVec late = rt - s.deadline;
+                const LaneVec missed = done & lt(zero, late);
+                const LaneVec delay = s.head_start - s.head_release;
+
+                s.completed -= done;
+                s.rt_sum += done & rt;
+                s.rt_max = select(done, vmax(s.rt_max, rt), s.rt_max);
+                s.miss -= missed;
+                s.late_sum += missed & late;
+                s.late_max = select(missed, vmax(s.late_max, late), s.late_max);
+                s.start_min = select(done, vmin(s.start_min, delay), s.start_min);
+                s.start_max = select(done, vmax(s.start_max, delay), s.start_max);
+
+                s.pending += done;
+                s.head_release += done & s.period;
+                s.head_rem = select(done, lt(zero, s.pending) & s.wcet, rem);
+                s.head_start = select(done, none, s.head_start);
+                any_done = any_done | done;
+                last_task = select(done, none, select(run, idx, last_task));
+            }
+            ls.last_task = last_task;
+
+            // Slot liberi del JobPool equivalente dopo il completamento
+            ls.free_peak = vmax(ls.free_peak, ls.live_peak - (live + any_done));
+            ls.now = finish;
+        }
+    }
+
+    // Metriche per task set (stesso ordine del costruttore).
+    const std::vector<SimulationMetrics>& metrics() const { return metrics_; }
+
+private:
+    using LaneVec = lockstep_detail::LaneVec;
+
+    static constexpr tick_t never = std::numeric_limits<tick_t>::max();
+
+    // Stato di un task per tutte le lane.
+    struct TaskLanes {
+        LaneVec period{}, deadline{}, wcet{}, prio{};
+        LaneVec next_release{}, pending{}, head_release{}, head_rem{}, head_start{};
+        LaneVec released{}, completed{}, miss{}, rt_sum{}, rt_max{}, late_sum{}, late_max{};
+        LaneVec start_min{}, start_max{}, switches{}, preempted{};
+    };
+
+    // Stato per lane: task set assegnato (-1 = nessuno), tempo, horizon e contatori globali.
+    struct LaneState {
+        std::array<std::int64_t, W> set{};
+        LaneVec now{}, horizon{};
+        LaneVec busy{}, live_peak{}, free_peak{};
+        LaneVec last_task{};    // task dell'ultimo job eseguito e non terminato
+    };
+
+    // Chiave primaria di selezione del job in testa (minore = scelto); a parità vince il
+    // rilascio più vecchio e poi l'indice di task più basso, come nelle ready queue.
+    static LaneVec primary_key(const TaskLanes& s, LaneVec now) {
+        if constexpr (std::is_same_v<Policy, PolicyFPP>) {
+            return s.prio;
+        } else if constexpr (std::is_same_v<Policy, PolicyDM>) {
+            return s.deadline;
+        } else if constexpr (std::is_same_v<Policy, PolicyEDF>) {
+            return s.head_release + s.deadline;
+        } else {
+            static_assert(std::is_same_v<Policy, PolicyLLF>, "LockstepSimulator: unsupported policy");
+            return s.head_release + s.deadline - now - s.head_rem;
+        }
+    }
+
+    // LLF: a parità di laxity vince la deadline assoluta più vicina (poi il rilascio).
+    static LaneVec secondary_key(const TaskLanes& s) {
+        if constexpr (std::is_same_v<Policy, PolicyLLF>) {
+            return s.head_release + s.deadline;
+        } else {
+            return s.head_release;
+        }
+    }
+
+    // Assegna alla lane `l` il prossimo task set (o nessuno) con lo stato iniziale.
+    void load_lane(std::size_t l) {
+        const bool present_set = next_set_ < tasksets_.size();
+        const std::size_t set = next_set_;
+        if (present_set) next_set_++;
+
+        lanes_.set[l] = present_set ? static_cast<std::int64_t>(set) : -1;
+        lanes_.now[l] = 0;
+        lanes_.horizon[l] = present_set ? horizons_[set] : 0;
+        lanes_.busy[l] = 0;
+        lanes_.live_peak[l] = 0;
+        lanes_.free_peak[l] = 0;
+        lanes_.last_task[l] = -1;
+
+        // Task assenti (o lane vuota): mai rilasciati.
+        for (std::size_t i = 0; i < tl_.size(); ++i) {
+            const bool present = present_set && i < tasksets_[set].size();
+            const Task t = present ? tasksets_[set][i] : Task{};
+            TaskLanes& s = tl_[i];
+            s.period[l] = t.period;
+            s.deadline[l] = t.deadline;
+            s.wcet[l] = t.wcet;
+            s.prio[l] = t.priority;
+            s.next_release[l] = present ? t.offset : never;
+            s.pending[l] = 0;
+            s.head_release[l] = 0;
+            s.head_rem[l] = 0;
+            s.head_start[l] = -1;
+            s.released[l] = 0;
+            s.completed[l] = 0;
+            s.miss[l] = 0;
+            s.rt_sum[l] = 0;
+            s.rt_max[l] = 0;
+            s.late_sum[l] = 0;
+            s.late_max[l] = 0;
+            s.start_min[l] = never;
+            s.start_max[l] = 0;
+            s.switches[l] = 0;
+            s.preempted[l] = 0;
+        }
+    }
+
+    // Metriche del task set della lane `l` (arrivata al suo horizon).
+    void store_lane(std::size_t l) {
+        const auto set = static_cast<std::size_t>(lanes_.set[l]);
+        const auto& tasks = tasksets_[set];
+        SimulationMetrics& m = metrics_[set];
+        m.init_from_tasks(tasks, horizons_[set]);
+        m.busy_ticks = lanes_.busy[l];
+        m.peak_live_jobs = lanes_.live_peak[l];
+        m.peak_job_bytes = static_cast<std::int64_t>(JobPool::allocated_bytes_for(
+            static_cast<std::size_t>(lanes_.live_peak[l]), static_cast<std::size_t>(lanes_.free_peak[l])));
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            const TaskLanes& s = tl_[i];
+            TaskMetrics& tm = m.per_task[i];
+            tm.jobs_released = s.released[l];
+            tm.jobs_completed = s.completed[l];
+            tm.deadline_miss = s.miss[l];
+            tm.rt_sum = s.rt_sum[l];
+            tm.rt_max = s.rt_max[l];
+            tm.lateness_sum = s.late_sum[l];
+            tm.lateness_max = s.late_max[l];
+            tm.start_delay_min = s.start_min[l];
+            tm.start_delay_max = s.start_max[l];
+            tm.context_switches = s.switches[l];
+            tm.preemptions = s.preempted[l];
+            m.context_switches += tm.context_switches;
+            m.preemptions_total += tm.preemptions;
+        }
+        m.finalize();
+    }
+
+    std::vector<std::vector<Task>> tasksets_;
+    std::vector<tick_t> horizons_;
+    std::size_t max_tasks_ = 0;
+    std::vector<SimulationMetrics> metrics_;
+
+    std::vector<TaskLanes> tl_;
+    LaneState lanes_;
+    std::size_t next_set_ = 0;
+};
+
+} // namespace rt
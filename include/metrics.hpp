@@ -2,8 +2,11 @@
 // Created by Francesco on 17/02/2026.
 //
 // Strutture per la raccolta di metriche di simulazione:
-// - metriche globali (utilization, deadline miss, unfinished jobs)
+// - metriche globali (utilization, deadline miss, unfinished jobs, utilizzazione per core)
 // - metriche per task (numero job, response time medio/max, lateness, unfinished)
+// - distribuzioni per task (istogrammi di response time, lateness e ritardo di avvio),
+//   raccolte solo su richiesta: costano una frazione sensibile del motore a eventi
+// - tick e motivo dell'eventuale terminazione anticipata della run
 
 #pragma once
 
@@ -12,12 +15,37 @@
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <algorithm>
+#include <limits>
 
 #include "task.hpp"
 #include "job.hpp"
+#include "histogram.hpp"
 
 namespace rt {
 
+// Motivo della terminazione anticipata di una run (vedi StopConditions in simulator.hpp).
+enum class StopReason : std::uint8_t {
+    None,           // run arrivata all'horizon
+    FirstMiss,      // primo deadline miss
+    MissCount,      // raggiunto il numero massimo di deadline miss
+    TaskMiss,       // deadline miss del task osservato
+    Backlog,        // troppi job rilasciati e non completati
+    RtaUnschedulable // non simulata: RTA esatta dimostra un deadline miss (RtaMode::Prefilter)
+};
+
+inline const char* stop_reason_name(StopReason r) {
+    switch (r) {
+        case StopReason::None:      return "none";
+        case StopReason::FirstMiss: return "first_miss";
+        case StopReason::MissCount: return "miss_count";
+        case StopReason::TaskMiss:  return "task_miss";
+        case StopReason::Backlog:   return "backlog";
+        case StopReason::RtaUnschedulable: return "rta_unschedulable";
+    }
+    return "unknown";
+}
+
 struct TaskMetrics {
     id_t task_id = 0;
 
@@ -38,6 +66,27 @@ struct TaskMetrics {
     tick_t lateness_sum = 0;
     tick_t lateness_max = 0;
 
+    // Context switch verso job del task e preemption subite dai suoi job.
+    std::int64_t context_switches = 0;
+    std::int64_t preemptions = 0;
+
+    // Multiprocessore: core assegnato dal partizionamento (-1 con scheduling globale)
+    // e migrazioni dei job del task (ripresa su un core diverso dall'ultimo).
+    std::int32_t core = 0;
+    std::int64_t migrations = 0;
+
+    // Ritardo di avvio (start - release) minimo e massimo, per lo start jitter.
+    tick_t start_delay_min = std::numeric_limits<tick_t>::max();
+    tick_t start_delay_max = 0;
+
+    // Distribuzioni dei job completati (quantili senza memorizzare i singoli job):
+    // response time, lateness (0 se in tempo) e ritardo di avvio (start - release).
+    // Registrate solo con histograms = true (vedi set_histograms dei simulatori).
+    bool histograms = false;
+    LogHistogram rt_hist;
+    LogHistogram late_hist;
+    LogHistogram start_hist;
+
     void on_job_released() {
         jobs_released++;
     }
@@ -48,18 +97,71 @@ struct TaskMetrics {
         if (auto rt = j.response_time(); rt.has_value()) {
             rt_sum += *rt;
             if (*rt > rt_max) rt_max = *rt;
+            if (histograms) rt_hist.record(*rt);
         }
 
-        if (j.finish_time.has_value()) {
-            tick_t late = *j.finish_time - j.abs_deadline;
+        if (j.is_finished()) {
+            tick_t late = j.finish_time - j.abs_deadline;
             if (late > 0) {
                 lateness_sum += late;
                 if (late > lateness_max) lateness_max = late;
                 deadline_miss++;
             }
+            if (histograms) late_hist.record(late);
+        }
+
+        if (j.has_started()) {
+            const tick_t delay = j.start_time - j.release_time;
+            start_delay_min = std::min(start_delay_min, delay);
+            start_delay_max = std::max(start_delay_max, delay);
+            if (histograms) start_hist.record(delay);
         }
     }
 
+    // Somma le metriche di un altro task (stesso task in run diverse o aggregati).
+    void merge(const TaskMetrics& o) {
+        jobs_released += o.jobs_released;
+        jobs_completed += o.jobs_completed;
+        deadline_miss += o.deadline_miss;
+        unfinished += o.unfinished;
+        rt_sum += o.rt_sum;
+        rt_max = std::max(rt_max, o.rt_max);
+        lateness_sum += o.lateness_sum;
+        lateness_max = std::max(lateness_max, o.lateness_max);
+        context_switches += o.context_switches;
+        preemptions += o.preemptions;
+        migrations += o.migrations;
+        start_delay_min = std::min(start_delay_min, o.start_delay_min);
+        start_delay_max = std::max(start_delay_max, o.start_delay_max);
+        histograms = histograms || o.histograms;
+        rt_hist.merge(o.rt_hist);
+        late_hist.merge(o.late_hist);
+        start_hist.merge(o.start_hist);
+    }
+
+    // Stato salvato nei checkpoint delle campagne (distribuzioni aggregate per politica).
+    void save(std::ostream& os) const {
+        os << task_id << ' ' << jobs_released << ' ' << jobs_completed << ' ' << deadline_miss << ' '
+           << unfinished << ' ' << rt_sum << ' ' << rt_max << ' ' << lateness_sum << ' '
+           << lateness_max << ' ' << context_switches << ' ' << preemptions << ' '
+           << core << ' ' << migrations << ' ' << start_delay_min << ' ' << start_delay_max << ' '
+           << histograms << ' ';
+        rt_hist.save(os);
+        os << ' ';
+        late_hist.save(os);
+        os << ' ';
+        start_hist.save(os);
+    }
+
+    void load(std::istream& is) {
+        is >> task_id >> jobs_released >> jobs_completed >> deadline_miss >> unfinished
+           >> rt_sum >> rt_max >> lateness_sum >> lateness_max >> context_switches >> preemptions
+           >> core >> migrations >> start_delay_min >> start_delay_max >> histograms;
+        rt_hist.load(is);
+        late_hist.load(is);
+        start_hist.load(is);
+    }
+
     void finalize_unfinished() {
         unfinished = jobs_released - jobs_completed;
     }
@@ -73,6 +175,16 @@ struct TaskMetrics {
         if (jobs_completed == 0) return 0.0;
         return static_cast<double>(lateness_sum) / static_cast<double>(jobs_completed);
     }
+
+    // Start jitter: variazione del ritardo di avvio tra i job completati.
+    tick_t start_jitter() const {
+        return start_delay_min <= start_delay_max ? start_delay_max - start_delay_min : 0;
+    }
+
+    // Quantili delle distribuzioni; -1 se gli istogrammi non sono raccolti.
+    tick_t rt_quantile(double q) const { return histograms ? rt_hist.quantile(q) : -1; }
+    tick_t late_quantile(double q) const { return histograms ? late_hist.quantile(q) : -1; }
+    tick_t start_quantile(double q) const { return histograms ? start_hist.quantile(q) : -1; }
 };
 
 struct SimulationMetrics {
@@ -82,23 +194,96 @@ struct SimulationMetrics {
     std::int64_t deadline_miss_total = 0;
     std::int64_t unfinished_total = 0;
 
+    // Picco di job contemporaneamente vivi e memoria allocata per memorizzarli.
+    std::int64_t peak_live_jobs = 0;
+    std::int64_t peak_job_bytes = 0;
+
+    // Context switch, preemption e tick di CPU spesi in overhead di switch
+    // (inclusi in busy_ticks, vedi BasicSimulator::set_switch_overhead).
+    std::int64_t context_switches = 0;
+    std::int64_t preemptions_total = 0;
+    tick_t switch_overhead_ticks = 0;
+
+    // Tick occupati per core (uniprocessore: un solo core, pari a busy_ticks) e
+    // migrazioni totali (solo scheduling globale, vedi multiprocessor.hpp).
+    std::vector<tick_t> core_busy_ticks;
+    std::int64_t migrations = 0;
+
+    // Breakdown dei WCET (BatchConfig::breakdown_search, vedi sensitivity.hpp):
+    // fattore di scala critico e utilizzazione corrispondente, -1 se non calcolati.
+    double critical_scaling = -1.0;
+    double breakdown_utilization = -1.0;
+
+    // Terminazione anticipata: tick in cui la run si è fermata (horizon se completa) e
+    // motivo. Le altre metriche coprono solo [0, stop_tick).
+    tick_t stop_tick = 0;
+    StopReason stop_reason = StopReason::None;
+
+    // Tick non simulati ma ricavati per estrapolazione da uno stato stazionario
+    // (cicli di iperperiodo identici, vedi BasicSimulator::set_steady_state).
+    tick_t extrapolated_ticks = 0;
+
     std::vector<TaskMetrics> per_task;
 
+    std::size_t cores() const { return std::max<std::size_t>(core_busy_ticks.size(), 1); }
+
+    // Run con almeno un deadline miss, anche se fermata prima che il job in ritardo completasse
+    // (o non simulata perché la RTA esatta dimostra il miss).
+    bool missed_deadline() const {
+        return deadline_miss_total > 0 || stop_reason == StopReason::FirstMiss ||
+               stop_reason == StopReason::MissCount || stop_reason == StopReason::TaskMiss ||
+               stop_reason == StopReason::RtaUnschedulable;
+    }
+
+    // Utilizzazione della piattaforma: busy / (stop_tick * core), cioè sul tratto simulato
+    // (stop_tick = horizon se la run non si è fermata; 0 per le run scartate dalla RTA).
     double utilization() const {
-        return horizon > 0 ? static_cast<double>(busy_ticks) / static_cast<double>(horizon) : 0.0;
+        return stop_tick > 0
+            ? static_cast<double>(busy_ticks) / (static_cast<double>(stop_tick) * static_cast<double>(cores()))
+            : 0.0;
+    }
+
+    double core_utilization(std::size_t core) const {
+        return stop_tick > 0 ? static_cast<double>(core_busy_ticks[core]) / static_cast<double>(stop_tick) : 0.0;
     }
 
-    void init_from_tasks(const std::vector<Task>& tasks, tick_t horizon_ticks) {
+    double core_utilization_min() const {
+        double u = core_busy_ticks.empty() ? 0.0 : core_utilization(0);
+        for (std::size_t c = 1; c < core_busy_ticks.size(); ++c) u = std::min(u, core_utilization(c));
+        return u;
+    }
+
+    double core_utilization_max() const {
+        double u = 0.0;
+        for (std::size_t c = 0; c < core_busy_ticks.size(); ++c) u = std::max(u, core_utilization(c));
+        return u;
+    }
+
+    void init_from_tasks(const std::vector<Task>& tasks, tick_t horizon_ticks, std::size_t n_cores = 1,
+                         bool histograms = false) {
         horizon = horizon_ticks;
         busy_ticks = 0;
         deadline_miss_total = 0;
         unfinished_total = 0;
+        peak_live_jobs = 0;
+        peak_job_bytes = 0;
+        context_switches = 0;
+        preemptions_total = 0;
+        switch_overhead_ticks = 0;
+        core_busy_ticks.assign(n_cores, 0);
+        migrations = 0;
+        critical_scaling = -1.0;
+        breakdown_utilization = -1.0;
+        stop_tick = horizon_ticks;
+        stop_reason = StopReason::None;
+        extrapolated_ticks = 0;
 
         per_task.clear();
         per_task.reserve(tasks.size());
         for (const auto& t : tasks) {
             TaskMetrics tm;
             tm.task_id = t.id;
+            tm.histograms = histograms;
             per_task.push_back(tm);
         }
     }
@@ -106,9 +291,11 @@ struct SimulationMetrics {
     // Chiamare alla fine della simulazione per calcolare metriche aggregate:
     // - deadline_miss_total
     // - unfinished_total
+    // - core_busy_ticks (solo uniprocessore, dove coincide con busy_ticks)
     void finalize() {
         deadline_miss_total = 0;
         unfinished_total = 0;
+        if (core_busy_ticks.size() == 1) core_busy_ticks[0] = busy_ticks;
 
         for (auto& tm : per_task) {
             tm.finalize_unfinished();
@@ -123,9 +310,32 @@ struct SimulationMetrics {
         os << "Horizon (ticks): " << horizon << "   (1 tick = 1 ms)\n";
         os << "CPU busy ticks:  " << busy_ticks << "\n";
         os << "CPU utilization: " << std::fixed << std::setprecision(6) << utilization() << "\n";
+        if (core_busy_ticks.size() > 1) {
+            os << "Cores:           " << core_busy_ticks.size() << "  (utilization";
+            for (std::size_t c = 0; c < core_busy_ticks.size(); ++c) {
+                os << (c == 0 ? " " : " / ") << std::fixed << std::setprecision(3) << core_utilization(c);
+            }
+            os << ", " << migrations << " migrations)\n";
+        }
         os << "Deadline miss:   " << deadline_miss_total << "\n";
         os << "Unfinished jobs: " << unfinished_total
            << "  (released but not completed within horizon)\n";
+        os << "Ctx switches:    " << context_switches
+           << "  (" << preemptions_total << " preemptions, "
+           << switch_overhead_ticks << " overhead ticks)\n";
+        os << "Peak live jobs:  " << peak_live_jobs
+           << "  (" << peak_job_bytes << " bytes of job storage)\n";
+        if (critical_scaling >= 0.0) {
+            os << "WCET breakdown:  x" << std::fixed << std::setprecision(4) << critical_scaling
+               << "  (utilization " << breakdown_utilization << ")\n";
+        }
+        if (stop_reason != StopReason::None) {
+            os << "Stopped at:      " << stop_tick << "  (" << stop_reason_name(stop_reason) << ")\n";
+        }
+        if (extrapolated_ticks > 0) {
+            os << "Extrapolated:    " << extrapolated_ticks
+               << " ticks  (steady state, repeated hyperperiods)\n";
+        }
 
         os << "\nPer-task metrics:\n";
         os << std::left
@@ -140,11 +350,13 @@ struct SimulationMetrics {
            << std::setw(12) << "Unfinished"
            << std::setw(12) << "RT_avg"
            << std::setw(10) << "RT_max"
+           << std::setw(10) << "RT_p99"
            << std::setw(12) << "Late_avg"
            << std::setw(10) << "Late_max"
+           << std::setw(10) << "Jitter"
            << "\n";
 
-        os << std::string(6+6+6+6+6+10+10+10+12+12+10+12+10, '-') << "\n";
+        os << std::string(6+6+6+6+6+10+10+10+12+12+10+10+12+10+10, '-') << "\n";
 
         // Assumiamo che per_task sia ordinato nello stesso ordine di tasks (task_index).
         for (size_t i = 0; i < tasks.size(); ++i) {
@@ -163,8 +375,10 @@ struct SimulationMetrics {
                << std::setw(12) << m.unfinished
                << std::setw(12) << std::fixed << std::setprecision(3) << m.avg_response_time()
                << std::setw(10) << m.rt_max
+               << std::setw(10) << m.rt_quantile(0.99)
                << std::setw(12) << std::fixed << std::setprecision(3) << m.avg_lateness()
                << std::setw(10) << m.lateness_max
+               << std::setw(10) << m.start_jitter()
                << "\n";
         }
 
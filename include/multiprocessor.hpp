@@ -0,0 +1,456 @@
+// multiprocessor.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Simulazione su m core identici:
+// - GlobalSimulator<Policy>: scheduling globale a priorità fissa (FPP, DM). A ogni passo
+//   eseguono i primi m job pronti, al più uno per task (i job di uno stesso task restano
+//   sequenziali). La selezione visita la ReadyQueueFPP in ordine (bitmap dei livelli),
+//   chiude un livello appena ne ha scelto tutti i task pronti (il backlog dei task scelti
+//   non viene visitato) e si ferma dopo m job: con priorità distinte il costo è
+//   O(m + livelli), non proporzionale ai job pronti.
+//   Un job già in esecuzione resta sul suo core; un job che riprende preferisce l'ultimo
+//   core usato, altrimenti il primo libero (migrazione contata per task).
+// - PartitionedSimulator<Policy>: task assegnati ai core con bin packing sull'utilizzazione
+//   (first-fit o worst-fit, task in ordine di utilizzazione decrescente), poi un
+//   BasicSimulator<Policy> indipendente per core; le metriche vengono riunite per task.
+// Metriche: busy_ticks è la somma sui core, core_busy_ticks il dettaglio per core,
+// utilization() è normalizzata sul numero di core. Con lo scheduling globale la traccia,
+// lo stato stazionario e l'overhead di switch non sono supportati.
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "task.hpp"
+#include "job.hpp"
+#include "job_pool.hpp"
+#include "scheduler.hpp"
+#include "ready_queue.hpp"
+#include "release_calendar.hpp"
+#include "metrics.hpp"
+#include "simulator.hpp"
+
+namespace rt {
+
+enum class MpScheduling {
+    Global,
+    Partitioned
+};
+
+enum class PartitionHeuristic {
+    FirstFit,   // primo core in cui il task entra
+    WorstFit    // core meno carico
+};
+
+struct TaskPartition {
+    std::vector<std::int32_t> core_of_task;     // stesso ordine dei task
+    std::vector<double> core_utilization;       // somma di C/T dei task del core
+
+    // Ogni core ha utilizzazione <= 1. Se falso, i task che non entravano in nessun core
+    // sono stati assegnati al core meno carico (sovraccarico visibile nei deadline miss).
+    bool fits = true;
+};
+
+inline TaskPartition partition_tasks(const std::vector<Task>& tasks, std::size_t cores,
+                                     PartitionHeuristic heuristic) {
+    if (cores == 0) throw std::invalid_argument("partition_tasks: cores must be > 0");
+
+    TaskPartition p;
+    p.core_of_task.assign(tasks.size(), -1);
+    p.core_utilization.assign(cores, 0.0);
+
+    auto util = [&](std::size_t i) {
+        return static_cast<double>(tasks[i].wcet) / static_cast<double>(tasks[i].period);
+    };
+
+    std::vector<std::size_t> order(tasks.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return util(a) > util(b); });
+
+    constexpr double eps = 1e-9;
+    for (const std::size_t i : order) {
+        const double u = util(i);
+        const auto least = static_cast<std::size_t>(
+            std::min_element(p.core_utilization.begin(), p.core_utilization.end()) - p.core_utilization.begin());
+
+        std::size_t core = cores;
+        if (heuristic == PartitionHeuristic::FirstFit) {
+            for (std::size_t c = 0; c < cores; ++c) {
+                if (p.core_utilization[c] + u <= 1.0 + eps) {
+                    core = c;
+                    break;
+                }
+            }
+        } else if (p.core_utilization[least] + u <= 1.0 + eps) {
+            core = least;
+        }
+
+        if (core == cores) {
+            core = least;
+            p.fits = false;
+        }
+        p.core_of_task[i] = static_cast<std::int32_t>(core);
+        p.core_utilization[core] += u;
+    }
+    return p;
+}
+
+namespace mp_detail {
+
+inline void print_taskset(std::ostream& os, const std::vector<Task>& tasks,
+                          const std::vector<TaskMetrics>& per_task) {
+    os << "=== Task set ===\n";
+    os << std::left
+       << std::setw(6) << "Idx"
+       << std::setw(6) << "ID"
+       << std::setw(6) << "Prio"
+       << std::setw(6) << "T"
+       << std::setw(6) << "D"
+       << std::setw(6) << "C"
+       << std::setw(6) << "O"
+       << std::setw(6) << "Core" // core del partizionamento ("-" = globale)
+       << "\n";
+    os << std::string(6*8, '-') << "\n";
+
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        const auto& t = tasks[i];
+        os << std::left
+           << std::setw(6) << i
+           << std::setw(6) << t.id
+           << std::setw(6) << t.priority
+           << std::setw(6) << t.period
+           << std::setw(6) << t.deadline
+           << std::setw(6) << t.wcet
+           << std::setw(6) << t.offset
+           << std::setw(6) << (per_task[i].core >= 0 ? std::to_string(per_task[i].core) : std::string("-"))
+           << "\n";
+    }
+    os << "\n";
+}
+
+} // namespace mp_detail
+
+template <typename Policy = PolicyFPP>
+class GlobalSimulator {
+    static_assert(std::is_same_v<Policy, PolicyFPP> || std::is_same_v<Policy, PolicyDM>,
+                  "GlobalSimulator: only fixed-priority policies (FPP, DM) are supported");
+
+public:
+    GlobalSimulator(std::vector<Task> tasks, tick_t horizon, std::size_t cores,
+                    SimEngine engine = SimEngine::Tick)
+        : tasks_(std::move(tasks)), horizon_(horizon), engine_(engine), cores_(cores)
+    {
+        if (cores_ == 0) throw std::invalid_argument("GlobalSimulator: cores must be > 0");
+        for (auto& t : tasks_) t.validate();
+        table_.assign(tasks_);
+        ready_.init_from_tasks(tasks_);
+        metrics_.init_from_tasks(tasks_, horizon_, cores_);
+    }
+
+    // Istogrammi per task nelle run successive (vedi BasicSimulator::set_histograms).
+    void set_histograms(bool enabled) { histograms_ = enabled; }
+
+    void run(bool print_input = true, bool print_summary = true) {
+        reset();
+
+        if (print_input) {
+            mp_detail::print_taskset(std::cout, tasks_, metrics_.per_task);
+            std::cout << "Policy: Global " << Policy::description << " on " << cores_ << " cores\n";
+            std::cout << "Horizon: " << horizon_ << " ticks (1 tick = 1 ms)\n\n";
+        }
+
+        tick_t t = 0;
+        while (t < horizon_) {
+            // 1) Release dei job con rilascio in t
+            if (t == releases_.next_time()) {
+                releases_.release_due(t, [&](std::int32_t ti) { release_job(ti, t); });
+            }
+
+            // 2) Selezione dei primi m job e assegnazione ai core
+            select_jobs();
+            dispatch();
+
+            // 3) Esecuzione: un tick, o fino al prossimo rilascio / completamento
+            tick_t step = 1;
+            if (engine_ == SimEngine::Event) {
+                step = std::min(horizon_, releases_.next_time()) - t;
+                for (const std::size_t slot : core_job_) {
+                    if (slot != no_slot) step = std::min(step, jobs_.remaining(slot));
+                }
+            }
+            execute(t, step);
+            t += step;
+        }
+
+        metrics_.peak_live_jobs = static_cast<std::int64_t>(jobs_.peak_live());
+        metrics_.peak_job_bytes = static_cast<std::int64_t>(jobs_.allocated_bytes());
+        metrics_.finalize();
+
+        if (print_summary) {
+            metrics_.print_summary(std::cout, tasks_);
+            std::cout << "\n";
+        }
+    }
+
+    const SimulationMetrics& metrics() const { return metrics_; }
+
+private:
+    static constexpr std::size_t no_slot = std::numeric_limits<std::size_t>::max();
+
+    void reset() {
+        jobs_.clear();
+        ready_.clear();
+        releases_.init_from_tasks(tasks_);
+        job_counter_.assign(tasks_.size(), 0);
+
+        metrics_.init_from_tasks(tasks_, horizon_, cores_, histograms_);
+        for (auto& tm : metrics_.per_task) tm.core = -1;
+
+        core_job_.assign(cores_, no_slot);
+        next_job_.assign(cores_, no_slot);
+        last_core_.clear();
+        queued_of_task_.assign(tasks_.size(), 0);
+        ready_tasks_.assign(ready_.levels(), 0);
+        task_selected_.assign(tasks_.size(), 0);
+        selected_in_level_.assign(ready_.levels(), 0);
+        selected_.clear();
+        selected_.reserve(cores_);
+    }
+
+    void release_job(std::int32_t ti, tick_t t) {
+        Job j;
+        j.task_id = table_.id[ti];
+        j.task_index = ti;
+        j.job_index = job_counter_[ti]++;
+        j.release_time = t;
+        j.abs_deadline = t + table_.deadline[ti];
+        j.remaining_time = table_.wcet[ti];
+
+        const std::size_t slot = jobs_.acquire(j);
+        if (slot >= last_core_.size()) last_core_.resize(slot + 1, -1);
+        last_core_[slot] = -1;
+        ready_.push(ti, slot, j);
+        if (queued_of_task_[ti]++ == 0) ready_tasks_[ready_.level_of(ti)]++;
+        metrics_.per_task[ti].on_job_released();
+    }
+
+    // Primi m job in ordine di priorità, al più uno per task (il più vecchio): i job
+    // successivi di task già scelti si incontrano solo a pari priorità, prima che il
+    // livello abbia dato tutti i suoi task pronti.
+    void select_jobs() {
+        selected_.clear();
+        if (ready_.empty()) return;
+
+        ready_.for_each_in_order([&](std::size_t slot) {
+            const std::int32_t ti = jobs_.task_index(slot);
+            if (task_selected_[ti]) return ReadyVisit::Next;
+            task_selected_[ti] = 1;
+            selected_.push_back(slot);
+            if (selected_.size() == cores_) return ReadyVisit::Stop;
+
+            const std::int32_t lvl = ready_.level_of(ti);
+            return ++selected_in_level_[lvl] == ready_tasks_[lvl] ? ReadyVisit::SkipLevel : ReadyVisit::Next;
+        });
+        for (const std::size_t slot : selected_) {
+            const std::int32_t ti = jobs_.task_index(slot);
+            task_selected_[ti] = 0;
+            selected_in_level_[ready_.level_of(ti)] = 0;
+        }
+    }
+
+    // Assegna i job selezionati ai core e conta switch, preemption e migrazioni.
+    void dispatch() {
+        std::fill(next_job_.begin(), next_job_.end(), no_slot);
+
+        // Chi era già in esecuzione resta sul suo core.
+        unplaced_.clear();
+        for (const std::size_t slot : selected_) {
+            const std::int32_t c = last_core_[slot];
+            if (c >= 0 && core_job_[c] == slot) {
+                next_job_[c] = slot;
+            } else {
+                unplaced_.push_back(slot);
+            }
+        }
+
+        // Gli altri: ultimo core usato se libero, altrimenti il primo core libero.
+        for (const std::size_t slot : unplaced_) {
+            std::int32_t c = last_core_[slot];
+            if (c < 0 || next_job_[c] != no_slot) {
+                c = static_cast<std::int32_t>(
+                    std::find(next_job_.begin(), next_job_.end(), no_slot) - next_job_.begin());
+            }
+            next_job_[c] = slot;
+        }
+
+        for (std::size_t c = 0; c < cores_; ++c) {
+            const std::size_t prev = core_job_[c];
+            const std::size_t next = next_job_[c];
+            if (prev == next) continue;
+
+            // Il job precedente non è terminato (al completamento il core si libera).
+            if (prev != no_slot) {
+                metrics_.preemptions_total++;
+                metrics_.per_task[jobs_.task_index(prev)].preemptions++;
+            }
+            if (next != no_slot) {
+                TaskMetrics& tm = metrics_.per_task[jobs_.task_index(next)];
+                metrics_.context_switches++;
+                tm.context_switches++;
+                if (last_core_[next] >= 0 && static_cast<std::size_t>(last_core_[next]) != c) {
+                    metrics_.migrations++;
+                    tm.migrations++;
+                }
+                last_core_[next] = static_cast<std::int32_t>(c);
+            }
+        }
+        core_job_.swap(next_job_);
+    }
+
+    void execute(tick_t t, tick_t step) {
+        for (std::size_t c = 0; c < cores_; ++c) {
+            const std::size_t slot = core_job_[c];
+            if (slot == no_slot) continue;
+
+            jobs_.execute_for(slot, t, step);
+            metrics_.busy_ticks += step;
+            metrics_.core_busy_ticks[c] += step;
+
+            if (jobs_.is_finished(slot)) {
+                const Job done = jobs_.get(slot);
+                metrics_.per_task[done.task_index].on_job_completed(done);
+                ready_.erase(done.task_index, slot);
+                if (--queued_of_task_[done.task_index] == 0) ready_tasks_[ready_.level_of(done.task_index)]--;
+                last_core_[slot] = -1;
+                jobs_.release(slot);
+                core_job_[c] = no_slot;
+            }
+        }
+    }
+
+    std::vector<Task> tasks_;
+    TaskTable table_;
+    JobPool jobs_;
+    typename Policy::ReadyQueue ready_;
+    ReleaseCalendar releases_;
+    tick_t horizon_;
+    SimEngine engine_;
+    std::size_t cores_;
+
+    std::vector<int> job_counter_;
+
+    std::vector<std::size_t> core_job_;         // job in esecuzione per core
+    std::vector<std::size_t> next_job_;         // assegnazione del passo corrente
+    std::vector<std::int32_t> last_core_;       // per slot: ultimo core usato (-1 = mai)
+    std::vector<std::size_t> selected_;
+    std::vector<std::size_t> unplaced_;
+
+    std::vector<std::int32_t> queued_of_task_;      // job in ready queue per task
+    std::vector<std::int32_t> ready_tasks_;         // task con job in coda, per livello
+    std::vector<char> task_selected_;               // scratch di select_jobs
+    std::vector<std::int32_t> selected_in_level_;   // scratch di select_jobs
+
+    SimulationMetrics metrics_;
+    bool histograms_ = false;
+};
+
+template <typename Policy>
+class PartitionedSimulator {
+public:
+    PartitionedSimulator(std::vector<Task> tasks, tick_t horizon, std::size_t cores,
+                         PartitionHeuristic heuristic = PartitionHeuristic::FirstFit,
+                         SimEngine engine = SimEngine::Tick)
+        : tasks_(std::move(tasks)), horizon_(horizon),
+          partition_(partition_tasks(tasks_, cores, heuristic)),
+          core_tasks_(cores)
+    {
+        for (auto& t : tasks_) t.validate();
+        for (std::size_t i = 0; i < tasks_.size(); ++i) {
+            core_tasks_[partition_.core_of_task[i]].push_back(i);
+        }
+
+        sims_.reserve(cores);
+        for (std::size_t c = 0; c < cores; ++c) {
+            std::vector<Task> subset;
+            subset.reserve(core_tasks_[c].size());
+            for (const std::size_t i : core_tasks_[c]) subset.push_back(tasks_[i]);
+            sims_.emplace_back(std::move(subset), horizon_, engine);
+        }
+    }
+
+    void set_steady_state(bool enabled) {
+        for (auto& s : sims_) s.set_steady_state(enabled);
+    }
+
+    void set_switch_overhead(tick_t ticks) {
+        for (auto& s : sims_) s.set_switch_overhead(ticks);
+    }
+
+    void set_histograms(bool enabled) {
+        for (auto& s : sims_) s.set_histograms(enabled);
+    }
+
+    const TaskPartition& partition() const { return partition_; }
+
+    void run(bool print_input = true, bool print_summary = true) {
+        metrics_.init_from_tasks(tasks_, horizon_, sims_.size());
+
+        for (std::size_t c = 0; c < sims_.size(); ++c) {
+            if (core_tasks_[c].empty()) continue;
+
+            sims_[c].run(false, false, false);
+            const SimulationMetrics& cm = sims_[c].metrics();
+
+            metrics_.busy_ticks += cm.busy_ticks;
+            metrics_.core_busy_ticks[c] = cm.busy_ticks;
+            metrics_.context_switches += cm.context_switches;
+            metrics_.preemptions_total += cm.preemptions_total;
+            metrics_.switch_overhead_ticks += cm.switch_overhead_ticks;
+            // Picchi dei core sommati: limite superiore del picco dell'intera piattaforma.
+            metrics_.peak_live_jobs += cm.peak_live_jobs;
+            metrics_.peak_job_bytes += cm.peak_job_bytes;
+            metrics_.extrapolated_ticks += cm.extrapolated_ticks;
+
+            for (std::size_t k = 0; k < core_tasks_[c].size(); ++k) {
+                metrics_.per_task[core_tasks_[c][k]] = cm.per_task[k];
+            }
+        }
+        for (std::size_t i = 0; i < tasks_.size(); ++i) {
+            metrics_.per_task[i].core = partition_.core_of_task[i];
+        }
+        metrics_.finalize();
+
+        if (print_input) {
+            mp_detail::print_taskset(std::cout, tasks_, metrics_.per_task);
+            std::cout << "Policy: Partitioned " << Policy::description << " on " << sims_.size() << " cores"
+                      << (partition_.fits ? "" : " (partition overloaded)") << "\n";
+            std::cout << "Horizon: " << horizon_ << " ticks (1 tick = 1 ms)\n\n";
+        }
+        if (print_summary) {
+            metrics_.print_summary(std::cout, tasks_);
+            std::cout << "\n";
+        }
+    }
+
+    const SimulationMetrics& metrics() const { return metrics_; }
+
+private:
+    std::vector<Task> tasks_;
+    tick_t horizon_;
+    TaskPartition partition_;
+    std::vector<std::vector<std::size_t>> core_tasks_;   // indici dei task per core
+    std::vector<BasicSimulator<Policy>> sims_;
+    SimulationMetrics metrics_;
+};
+
+} // namespace rt
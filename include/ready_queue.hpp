@@ -0,0 +1,307 @@
+// ready_queue.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Ready queue per le politiche di scheduling (una classe per politica, interfaccia comune):
+//   init_from_tasks, clear, empty, size, push(task_index, slot, job), top, pop,
+//   on_executed(ticks), stable_ticks()
+// Contengono solo job rilasciati e non completati: i job completati escono dal set "caldo".
+// Il job in esecuzione è sempre top(); pop() lo rimuove al completamento.
+// - ReadyQueueFPP: livelli di priorità FIFO + bitmap, selezione O(1) con find-first-set;
+//   per il multiprocessore anche visita in ordine (con salto del resto di un livello) ed
+//   erase di un job qualsiasi
+// - ReadyQueueDM:  come FPP, priorità = deadline relativa (Deadline Monotonic)
+// - ReadyQueueEDF: min-heap su (deadline assoluta, ordine di rilascio), O(log n)
+// - ReadyQueueLLF: minima laxity con scansione lineare (la laxity dei job cambia nel tempo)
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <cstdint>
+#include <bit>
+#include <tuple>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+
+#include "task.hpp"
+#include "job.hpp"
+
+namespace rt {
+
+// Esito di una visita di ReadyQueueFPP::for_each_in_order.
+enum class ReadyVisit {
+    Next,       // prossimo job
+    SkipLevel,  // nessun altro job di questo livello di priorità
+    Stop        // fine della visita
+};
+
+class ReadyQueueFPP {
+public:
+    ReadyQueueFPP() = default;
+
+    explicit ReadyQueueFPP(const std::vector<Task>& tasks) {
+        init_from_tasks(tasks);
+    }
+
+    // Mappa ogni task sul livello della sua priorità (0 = priorità più alta).
+    void init_from_tasks(const std::vector<Task>& tasks) {
+        std::vector<prio_t> keys;
+        keys.reserve(tasks.size());
+        for (const auto& t : tasks) keys.push_back(t.priority);
+        init_from_keys(keys);
+    }
+
+    // Chiave di priorità per task (minore = più alta); chiavi uguali condividono il livello.
+    void init_from_keys(const std::vector<prio_t>& keys) {
+        std::vector<prio_t> prios = keys;
+        std::sort(prios.begin(), prios.end());
+        prios.erase(std::unique(prios.begin(), prios.end()), prios.end());
+
+        level_of_task_.resize(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            const auto it = std::lower_bound(prios.begin(), prios.end(), keys[i]);
+            level_of_task_[i] = static_cast<std::int32_t>(it - prios.begin());
+        }
+
+        levels_.assign(prios.size(), {});
+        bitmap_.assign((prios.size() + 63) / 64, 0);
+        size_ = 0;
+    }
+
+    void clear() {
+        for (auto& l : levels_) l.clear();
+        std::fill(bitmap_.begin(), bitmap_.end(), 0);
+        size_ = 0;
+    }
+
+    bool empty() const { return size_ == 0; }
+    std::size_t size() const { return size_; }
+
+    // Inserisce un job (identificato dal suo slot) del task `task_index`.
+    void push(std::int32_t task_index, std::size_t job_slot) {
+        const std::int32_t lvl = level_of_task_[task_index];
+        levels_[lvl].push_back(job_slot);
+        bitmap_[lvl >> 6] |= (std::uint64_t{1} << (lvl & 63));
+        size_++;
+    }
+
+    void push(std::int32_t task_index, std::size_t job_slot, const Job&) {
+        push(task_index, job_slot);
+    }
+
+    // Slot del job a priorità più alta (il più vecchio a parità di priorità).
+    std::size_t top() const {
+        return levels_[top_level()].front();
+    }
+
+    // Rimuove il job restituito da top() (tipicamente appena completato).
+    void pop() {
+        const std::int32_t lvl = top_level();
+        levels_[lvl].pop_front();
+        if (levels_[lvl].empty()) {
+            bitmap_[lvl >> 6] &= ~(std::uint64_t{1} << (lvl & 63));
+        }
+        size_--;
+    }
+
+    // Visita gli slot in ordine di selezione (priorità, poi FIFO): visit(slot) restituisce
+    // ReadyVisit e può chiudere il livello corrente (es. backlog di un task già scelto) o
+    // l'intera visita. Costo proporzionale ai job visitati, non alla dimensione della coda.
+    template <typename F>
+    void for_each_in_order(F&& visit) const {
+        for (size_t w = 0; w < bitmap_.size(); ++w) {
+            for (std::uint64_t bits = bitmap_[w]; bits != 0; bits &= bits - 1) {
+                const auto lvl = w * 64 + static_cast<size_t>(std::countr_zero(bits));
+                for (const std::size_t slot : levels_[lvl]) {
+                    const ReadyVisit next = visit(slot);
+                    if (next == ReadyVisit::Stop) return;
+                    if (next == ReadyVisit::SkipLevel) break;
+                }
+            }
+        }
+    }
+
+    // Livello di priorità del task (0 = il più alto).
+    std::int32_t level_of(std::int32_t task_index) const { return level_of_task_[task_index]; }
+    std::size_t levels() const { return levels_.size(); }
+
+    // Rimuove il job nello slot (non necessariamente top(): es. completato su un altro core).
+    // Costo lineare solo nei job del suo livello che lo precedono.
+    void erase(std::int32_t task_index, std::size_t job_slot) {
+        const std::int32_t lvl = level_of_task_[task_index];
+        auto& level = levels_[lvl];
+        const auto it = std::find(level.begin(), level.end(), job_slot);
+        if (it == level.end()) throw std::logic_error("ReadyQueueFPP: erase() of a job not in queue");
+        level.erase(it);
+        if (level.empty()) {
+            bitmap_[lvl >> 6] &= ~(std::uint64_t{1} << (lvl & 63));
+        }
+        size_--;
+    }
+
+    // Priorità statiche: l'esecuzione non cambia l'ordine, la scelta cambia solo ai rilasci.
+    void on_executed(tick_t) {}
+    tick_t stable_ticks() const { return std::numeric_limits<tick_t>::max(); }
+
+private:
+    std::int32_t top_level() const {
+        for (size_t w = 0; w < bitmap_.size(); ++w) {
+            if (bitmap_[w] != 0) {
+                return static_cast<std::int32_t>(w * 64 + std::countr_zero(bitmap_[w]));
+            }
+        }
+        throw std::logic_error("ReadyQueueFPP: top() on empty queue");
+    }
+
+    std::vector<std::int32_t> level_of_task_;
+    std::vector<std::deque<std::size_t>> levels_;
+    std::vector<std::uint64_t> bitmap_;
+    std::size_t size_ = 0;
+};
+
+// Deadline Monotonic: priorità fissa = deadline relativa (a parità, FIFO come in FPP).
+class ReadyQueueDM : public ReadyQueueFPP {
+public:
+    void init_from_tasks(const std::vector<Task>& tasks) {
+        std::vector<prio_t> keys;
+        keys.reserve(tasks.size());
+        for (const auto& t : tasks) keys.push_back(static_cast<prio_t>(t.deadline));
+        init_from_keys(keys);
+    }
+};
+
+// Earliest Deadline First: min-heap su (deadline assoluta, sequenza di inserimento).
+// A parità di deadline vince il job rilasciato prima (stesso tie-break FIFO di FPP).
+class ReadyQueueEDF {
+public:
+    void init_from_tasks(const std::vector<Task>&) { clear(); }
+
+    void clear() {
+        heap_.clear();
+        seq_ = 0;
+    }
+
+    bool empty() const { return heap_.empty(); }
+    std::size_t size() const { return heap_.size(); }
+
+    void push(std::int32_t, std::size_t job_slot, const Job& j) {
+        heap_.push_back({j.abs_deadline, seq_++, job_slot});
+        std::push_heap(heap_.begin(), heap_.end(), later);
+    }
+
+    std::size_t top() const {
+        if (heap_.empty()) throw std::logic_error("ReadyQueueEDF: top() on empty queue");
+        return heap_.front().slot;
+    }
+
+    void pop() {
+        std::pop_heap(heap_.begin(), heap_.end(), later);
+        heap_.pop_back();
+    }
+
+    void on_executed(tick_t) {}
+    tick_t stable_ticks() const { return std::numeric_limits<tick_t>::max(); }
+
+private:
+    struct Entry {
+        tick_t deadline;
+        std::uint64_t seq;
+        std::size_t slot;
+    };
+
+    static bool later(const Entry& a, const Entry& b) {
+        if (a.deadline != b.deadline) return a.deadline > b.deadline;
+        return a.seq > b.seq;
+    }
+
+    std::vector<Entry> heap_;
+    std::uint64_t seq_ = 0;
+};
+
+// Least Laxity First: laxity = deadline assoluta - now - tempo residuo.
+// Poiché `now` è comune a tutti i job, si confronta la chiave (deadline - residuo):
+// resta costante per i job in attesa e cresce di 1 per ogni tick del job in esecuzione.
+// Tie-break: chiave, poi deadline assoluta, poi ordine di rilascio.
+// La selezione è una scansione lineare: le chiavi cambiano a ogni tick eseguito.
+class ReadyQueueLLF {
+public:
+    void init_from_tasks(const std::vector<Task>&) { clear(); }
+
+    void clear() {
+        entries_.clear();
+        seq_ = 0;
+        top_ = npos;
+    }
+
+    bool empty() const { return entries_.empty(); }
+    std::size_t size() const { return entries_.size(); }
+
+    void push(std::int32_t, std::size_t job_slot, const Job& j) {
+        entries_.push_back({j.abs_deadline - j.remaining_time, j.abs_deadline, seq_++, job_slot});
+        top_ = npos;
+    }
+
+    std::size_t top() const {
+        return entries_[top_index()].slot;
+    }
+
+    void pop() {
+        const std::size_t i = top_index();
+        entries_[i] = entries_.back();
+        entries_.pop_back();
+        top_ = npos;
+    }
+
+    // Il job in testa ha eseguito `ticks` tick: la sua chiave cresce di `ticks`.
+    void on_executed(tick_t ticks) {
+        entries_[top_index()].key += ticks;
+        top_ = npos;
+    }
+
+    // Tick consecutivi per cui il job in testa resta selezionato in assenza di rilasci.
+    tick_t stable_ticks() const {
+        const std::size_t r = top_index();
+        const Entry& run = entries_[r];
+        tick_t stable = std::numeric_limits<tick_t>::max();
+        for (std::size_t i = 0; i < entries_.size(); ++i) {
+            if (i == r) continue;
+            const Entry& o = entries_[i];
+            // Dopo s tick la chiave del job in testa vale run.key + s: perde al primo s
+            // per cui supera o.key, oppure la eguaglia perdendo il tie-break.
+            const bool wins_tie = std::tie(run.deadline, run.seq) < std::tie(o.deadline, o.seq);
+            stable = std::min(stable, o.key - run.key + (wins_tie ? 1 : 0));
+        }
+        return stable;
+    }
+
+private:
+    struct Entry {
+        tick_t key;         // deadline assoluta - tempo residuo
+        tick_t deadline;
+        std::uint64_t seq;
+        std::size_t slot;
+    };
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    std::size_t top_index() const {
+        if (entries_.empty()) throw std::logic_error("ReadyQueueLLF: top() on empty queue");
+        if (top_ == npos) {
+            std::size_t best = 0;
+            for (std::size_t i = 1; i < entries_.size(); ++i) {
+                const Entry& a = entries_[i];
+                const Entry& b = entries_[best];
+                if (std::tie(a.key, a.deadline, a.seq) < std::tie(b.key, b.deadline, b.seq)) best = i;
+            }
+            top_ = best;
+        }
+        return top_;
+    }
+
+    std::vector<Entry> entries_;
+    std::uint64_t seq_ = 0;
+    mutable std::size_t top_ = npos;    // cache della selezione, invalidata a ogni modifica
+};
+
+} // namespace rt
@@ -0,0 +1,90 @@
+// release_calendar.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Calendario dei rilasci: min-heap di (prossimo rilascio, indice task).
+// Sostituisce il controllo Task::releases_at(t) per ogni task a ogni tick:
+// il costo di gestione dei rilasci si paga solo nei tick in cui avviene un rilascio
+// (O(log n) per rilascio), anche con centinaia o migliaia di task.
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+
+#include "task.hpp"
+
+namespace rt {
+
+class ReleaseCalendar {
+public:
+    ReleaseCalendar() = default;
+
+    explicit ReleaseCalendar(const std::vector<Task>& tasks) {
+        init_from_tasks(tasks);
+    }
+
+    void init_from_tasks(const std::vector<Task>& tasks) {
+        periods_.resize(tasks.size());
+        heap_.clear();
+        heap_.reserve(tasks.size());
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            periods_[i] = tasks[i].period;
+            heap_.push_back({tasks[i].offset, static_cast<std::int32_t>(i)});
+        }
+        std::make_heap(heap_.begin(), heap_.end(), later);
+    }
+
+    // Istante del prossimo rilascio (max tick_t se non ci sono task).
+    tick_t next_time() const {
+        return heap_.empty() ? std::numeric_limits<tick_t>::max() : heap_.front().time;
+    }
+
+    // Invoca on_release(task_index) per ogni task che rilascia in t, in ordine crescente
+    // di indice (stesso ordine del controllo releases_at su tutti i task), e ne programma
+    // il rilascio successivo.
+    // Il rilascio successivo sostituisce la cima dello heap, che viene poi riposizionata
+    // con un solo sift-down (invece di pop_heap + push_heap).
+    template <typename F>
+    void release_due(tick_t t, F&& on_release) {
+        while (!heap_.empty() && heap_.front().time == t) {
+            Entry& e = heap_.front();
+            on_release(e.task_index);
+            e.time += periods_[e.task_index];
+            sift_down_top();
+        }
+    }
+
+private:
+    struct Entry {
+        tick_t time;
+        std::int32_t task_index;
+    };
+
+    // Ordine di heap: rilascio più vicino in cima, a parità di tempo indice più basso.
+    static bool later(const Entry& a, const Entry& b) {
+        if (a.time != b.time) return a.time > b.time;
+        return a.task_index > b.task_index;
+    }
+
+    void sift_down_top() {
+        const std::size_t n = heap_.size();
+        const Entry moving = heap_[0];
+        std::size_t i = 0;
+        for (;;) {
+            std::size_t child = 2 * i + 1;
+            if (child >= n) break;
+            if (child + 1 < n && later(heap_[child], heap_[child + 1])) child++;
+            if (!later(moving, heap_[child])) break;
+            heap_[i] = heap_[child];
+            i = child;
+        }
+        heap_[i] = moving;
+    }
+
+    std::vector<tick_t> periods_;
+    std::vector<Entry> heap_;
+};
+
+} // namespace rt
@@ -0,0 +1,93 @@
+// rta.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Response-Time Analysis (RTA) classica per FPP con deadline vincolate (D <= T):
+//   R_i = C_i + sum_{j in hep(i), j != i} ceil(R_i / T_j) * C_j
+// iterata fino a punto fisso o fino a superare D_i.
+// - con offset nulli e priorità distinte il risultato è esatto (istante critico in t = 0)
+// - altrimenti è un upper bound (i task a pari priorità sono contati come interferenza)
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <string>
+
+#include "task.hpp"
+#include "job.hpp"
+#include "metrics.hpp"
+
+namespace rt {
+
+struct RtaResult {
+    // WCRT per task (stesso ordine di tasks); no_tick se R_i supera la deadline.
+    std::vector<tick_t> wcrt;
+
+    // Tutti i task hanno R_i <= D_i.
+    bool schedulable = true;
+
+    // Vero se l'analisi è esatta per il task set (offset nulli, priorità distinte):
+    // in tal caso "non schedulabile" significa deadline miss garantito in simulazione.
+    bool exact = true;
+};
+
+inline RtaResult response_time_analysis(const std::vector<Task>& tasks) {
+    RtaResult res;
+    res.wcrt.assign(tasks.size(), no_tick);
+
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        if (tasks[i].offset != 0) res.exact = false;
+        for (size_t j = 0; j < i; ++j) {
+            if (tasks[j].priority == tasks[i].priority) res.exact = false;
+        }
+    }
+
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        const Task& ti = tasks[i];
+
+        tick_t r = ti.wcet;
+        for (size_t j = 0; j < tasks.size(); ++j) {
+            if (j != i && tasks[j].priority <= ti.priority) r += tasks[j].wcet;
+        }
+
+        for (;;) {
+            if (r > ti.deadline) break;
+
+            tick_t next = ti.wcet;
+            for (size_t j = 0; j < tasks.size(); ++j) {
+                if (j == i || tasks[j].priority > ti.priority) continue;
+                const Task& tj = tasks[j];
+                next += ((r + tj.period - 1) / tj.period) * tj.wcet;
+            }
+
+            if (next == r) {
+                res.wcrt[i] = r;
+                break;
+            }
+            r = next;
+        }
+
+        if (res.wcrt[i] == no_tick) res.schedulable = false;
+    }
+
+    return res;
+}
+
+// Verifica che i response time simulati non superino i bound RTA (per i task con R_i <= D_i).
+// Restituisce una descrizione della prima violazione, o stringa vuota se coerente.
+inline std::string rta_cross_check(const std::vector<Task>& tasks,
+                                   const RtaResult& rta,
+                                   const SimulationMetrics& m) {
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        if (rta.wcrt[i] == no_tick) continue;
+        if (m.per_task[i].rt_max > rta.wcrt[i]) {
+            return "task_index=" + std::to_string(i) +
+                   " task_id=" + std::to_string(tasks[i].id) +
+                   " simulated rt_max=" + std::to_string(m.per_task[i].rt_max) +
+                   " > RTA bound=" + std::to_string(rta.wcrt[i]);
+        }
+    }
+    return {};
+}
+
+} // namespace rt
@@ -3,6 +3,15 @@
 //
 // Selezione del job da eseguire secondo politica Fixed Priority Preemptive (FPP).
 // Priorità numerica più PICCOLA = priorità più ALTA.
+// - select_job(jobs, tasks, now): scansione lineare di tutti i job (riferimento)
+// - select_job(ready): lettura O(1) dalla ReadyQueueFPP (usata dal Simulator)
+//
+// Politiche di scheduling come tipi (parametro template di BasicSimulator): ogni politica
+// indica la sua ready queue, così la selezione nel loop caldo è risolta a compile time.
+// - PolicyFPP: priorità fissa dal task set
+// - PolicyDM:  Deadline Monotonic (priorità fissa = deadline relativa)
+// - PolicyEDF: Earliest Deadline First
+// - PolicyLLF: Least Laxity First
 
 #pragma once
 
@@ -11,6 +20,7 @@
 
 #include "job.hpp"
 #include "task.hpp"
+#include "ready_queue.hpp"
 
 namespace rt {
 
@@ -27,7 +37,7 @@ namespace rt {
                 const Job& job = jobs[i];
                 if (!job.is_ready(now)) continue;
 
-                const Task& task = tasks.at(job.task_index); // safe
+                const Task& task = tasks[job.task_index]; // indice interno, sempre valido
                 if (task.priority < best_priority) {
                     best_priority = task.priority;
                     selected_index = static_cast<int>(i);
@@ -35,6 +45,66 @@ namespace rt {
             }
             return selected_index;
         }
+
+        static int select_job(const ReadyQueueFPP& ready)
+        {
+            if (ready.empty()) return -1;
+            return static_cast<int>(ready.top());
+        }
+    };
+
+    struct PolicyFPP {
+        using ReadyQueue = ReadyQueueFPP;
+        static constexpr const char* name = "FPP";
+        static constexpr const char* description = "Fixed Priority Preemptive (FPP)";
+    };
+
+    struct PolicyDM {
+        using ReadyQueue = ReadyQueueDM;
+        static constexpr const char* name = "DM";
+        static constexpr const char* description = "Deadline Monotonic (DM)";
+    };
+
+    struct PolicyEDF {
+        using ReadyQueue = ReadyQueueEDF;
+        static constexpr const char* name = "EDF";
+        static constexpr const char* description = "Earliest Deadline First (EDF)";
+    };
+
+    struct PolicyLLF {
+        using ReadyQueue = ReadyQueueLLF;
+        static constexpr const char* name = "LLF";
+        static constexpr const char* description = "Least Laxity First (LLF)";
+    };
+
+    // Selezione della politica a runtime (es. BatchConfig::policies): il dispatch avviene
+    // una volta per run, la simulazione usa poi BasicSimulator<Policy>.
+    enum class SchedPolicy {
+        FPP,
+        DM,
+        EDF,
+        LLF
+    };
+
+    inline const char* policy_name(SchedPolicy p) {
+        switch (p) {
+            case SchedPolicy::FPP: return PolicyFPP::name;
+            case SchedPolicy::DM:  return PolicyDM::name;
+            case SchedPolicy::EDF: return PolicyEDF::name;
+            case SchedPolicy::LLF: return PolicyLLF::name;
+        }
+        return "?";
+    }
+
+    // Selezione generica sulla ready queue della politica: -1 se non c'è nessun job pronto.
+    template <typename Policy>
+    class Scheduler {
+    public:
+        static int select_job(const typename Policy::ReadyQueue& ready)
+        {
+            if (ready.empty()) return -1;
+            return static_cast<int>(ready.top());
+        }
     };
 
-} // namespace rt
\ No newline at end of file
+} // namespace rt
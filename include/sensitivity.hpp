@@ -0,0 +1,116 @@
+// sensitivity.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Analisi di sensitività sui WCET (breakdown utilization): massimo fattore di scala
+// alpha tale che il task set con C_i' = max(1, floor(alpha * C_i)) resti schedulabile
+// nell'horizon, cioè nessun job superi la deadline (anche se non completato).
+// - ricerca binaria su alpha in [0, min_i (D_i + 1) / C_i): oltre il limite superiore
+//   qualche C_i' > D_i e il miss è certo
+// - verdetto per ogni alpha: RTA se esatta (solo FPP, con l'horizon che copre tutte le
+//   prime deadline, vedi rta.hpp), altrimenti BasicSimulator<Policy> con terminazione al
+//   primo deadline miss
+// - warm start: un miss già osservato nella run con alpha = 1 restringe subito
+//   l'intervallo a [0, 1)
+// Il risultato è il più grande alpha verificato schedulabile (a meno della tolleranza).
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <optional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "task.hpp"
+#include "scheduler.hpp"
+#include "simulator.hpp"
+#include "rta.hpp"
+
+namespace rt {
+
+struct BreakdownConfig {
+    double tolerance = 1e-3;        // ampiezza finale dell'intervallo su alpha
+    SimEngine engine = SimEngine::Event;
+    bool steady_state = false;
+    tick_t switch_overhead = 0;     // con overhead la RTA non è applicabile
+    bool use_rta = true;
+};
+
+struct BreakdownResult {
+    double critical_scaling = 0.0;          // alpha critico (0 se nemmeno C_i = 1 è schedulabile)
+    double breakdown_utilization = 0.0;     // somma C_i' / T_i con alpha critico
+    int simulations = 0;                    // verdetti da simulazione
+    int rta_checks = 0;                     // verdetti da RTA
+};
+
+// WCET scalati di alpha (arrotondati per difetto, almeno 1 tick).
+inline std::vector<Task> scale_wcets(const std::vector<Task>& tasks, double alpha) {
+    std::vector<Task> out = tasks;
+    for (auto& t : out) {
+        const auto c = static_cast<tick_t>(std::floor(static_cast<double>(t.wcet) * alpha + 1e-9));
+        t.wcet = std::max<tick_t>(1, c);
+    }
+    return out;
+}
+
+template <typename Policy>
+BreakdownResult breakdown_search(const std::vector<Task>& tasks,
+                                 tick_t horizon,
+                                 const BreakdownConfig& cfg = {},
+                                 std::optional<bool> schedulable_at_one = std::nullopt)
+{
+    if (!(cfg.tolerance > 0.0)) throw std::invalid_argument("breakdown_search: tolerance must be > 0");
+
+    BreakdownResult res;
+    if (tasks.empty()) return res;
+
+    tick_t max_deadline = 0;
+    for (const auto& t : tasks) max_deadline = std::max(max_deadline, t.deadline);
+    const bool rta_usable = cfg.use_rta && cfg.switch_overhead == 0 && std::is_same_v<Policy, PolicyFPP> &&
+                            max_deadline <= horizon && response_time_analysis(tasks).exact;
+
+    auto schedulable = [&](double alpha) {
+        const std::vector<Task> scaled = scale_wcets(tasks, alpha);
+        for (const auto& t : scaled) {
+            if (t.wcet > t.deadline) return false;
+        }
+        if (rta_usable) {
+            res.rta_checks++;
+            return response_time_analysis(scaled).schedulable;
+        }
+        res.simulations++;
+        BasicSimulator<Policy> sim(scaled, horizon, cfg.engine);
+        sim.set_steady_state(cfg.steady_state);
+        sim.set_switch_overhead(cfg.switch_overhead);
+        sim.set_stop_on_deadline_miss(true);
+        sim.run(false, false, false);
+        return sim.first_miss_tick() == no_tick;
+    };
+
+    // hi: miss certo (qualche C_i' > D_i); lo: ultimo alpha schedulabile (0 da verificare).
+    double hi = std::numeric_limits<double>::infinity();
+    for (const auto& t : tasks) {
+        hi = std::min(hi, static_cast<double>(t.deadline + 1) / static_cast<double>(t.wcet));
+    }
+    double lo = 0.0;
+    if (schedulable_at_one.has_value() && 1.0 < hi) {
+        if (*schedulable_at_one) lo = 1.0;
+        else hi = 1.0;
+    }
+
+    while (hi - lo > cfg.tolerance) {
+        const double mid = lo + (hi - lo) / 2.0;
+        if (schedulable(mid)) lo = mid;
+        else hi = mid;
+    }
+    if (lo == 0.0 && !schedulable(0.0)) return res;
+
+    res.critical_scaling = lo;
+    res.breakdown_utilization = total_utilization(scale_wcets(tasks, lo));
+    return res;
+}
+
+} // namespace rt
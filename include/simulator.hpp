@@ -1,88 +1,183 @@
 // simulator.hpp
 // Created by Francesco on 17/02/2026.
 //
-// Simulatore tick-based per task real-time con politica FPP.
-// Raccoglie metriche per-task e globali (response time, lateness, deadline miss, utilization)
-// e può stampare una timeline di debug.
+// Simulatore per task real-time, parametrizzato sulla politica di scheduling
+// (BasicSimulator<Policy>, vedi scheduler.hpp); Simulator = politica FPP.
+// Due motori equivalenti (stesse SimulationMetrics):
+// - Tick:  avanza un tick alla volta fino all'horizon (riferimento)
+// - Event: salta direttamente tra eventi (rilascio, completamento, preemption),
+//          costo proporzionale al numero di job invece che al numero di tick
+// Raccoglie metriche per-task e globali (response time, lateness, deadline miss, utilization),
+// su richiesta le distribuzioni per task (set_histograms), e può registrare la timeline come traccia binaria (set_trace, vedi trace.hpp); la
+// timeline di debug testuale è resa dagli stessi record.
+//
+// Stato stazionario (set_steady_state): dopo l'offset massimo le fasi dei task si ripetono
+// a ogni iperperiodo H. Se a due checkpoint consecutivi (O_max + k*H) i job pendenti sono
+// identici (relativamente al checkpoint), anche i cicli successivi lo sono: i cicli interi
+// rimanenti non vengono simulati e le metriche additive sono estrapolate dall'ultimo ciclo
+// (i massimi restano invariati). Il risultato è identico alla simulazione completa.
+//
+// Context switch: ogni volta che va in esecuzione un job diverso dall'ultimo eseguito
+// (preemption se quest'ultimo non era terminato). Con set_switch_overhead(o) ogni switch
+// occupa la CPU per o tick prima che il job avanzi. Lo switch in corso non viene
+// interrotto: se nel frattempo arriva un job più prioritario, lo switch successivo paga
+// di nuovo l'overhead.
+//
+// Terminazione anticipata (set_stop_conditions, vedi StopConditions): un deadline miss è
+// rilevato al completamento in ritardo di un job o, prima, al rilascio del job successivo
+// dello stesso task mentre il precedente è ancora pendente (D <= T); ogni job in ritardo
+// conta una volta sola. Le condizioni sono valutate solo su rilasci e completamenti, mai
+// per tick. La run si ferma nel tick di rilevamento e le metriche coprono solo la parte
+// simulata (stop_tick e stop_reason nelle SimulationMetrics); first_miss_tick() indica la
+// deadline del primo miss, contando a fine run anche un job pendente con deadline entro
+// l'horizon.
 
 #pragma once
 
 #include <vector>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <optional>
 
 #include "task.hpp"
 #include "job.hpp"
+#include "job_pool.hpp"
 #include "scheduler.hpp"
+#include "ready_queue.hpp"
+#include "release_calendar.hpp"
 #include "metrics.hpp"
+#include "time_utils.hpp"
+#include "trace.hpp"
 
 namespace rt {
 
-class Simulator {
+enum class SimEngine {
+    Tick,
+    Event
+};
+
+// Condizioni di terminazione anticipata (valori di default = disabilitate).
+struct StopConditions {
+    bool first_miss = false;        // primo deadline miss
+    std::int64_t miss_count = 0;    // N-esimo deadline miss (0 = disabilitato)
+    id_t miss_task_id = -1;         // primo miss di un job del task con questo ID (-1 = disabilitato)
+    std::int64_t max_backlog = 0;   // più di N job vivi dopo un rilascio (0 = disabilitato)
+
+    bool any() const { return first_miss || miss_count > 0 || miss_task_id >= 0 || max_backlog > 0; }
+
+    void validate() const {
+        if (miss_count < 0) throw std::invalid_argument("StopConditions.miss_count must be >= 0");
+        if (max_backlog < 0) throw std::invalid_argument("StopConditions.max_backlog must be >= 0");
+    }
+};
+
+template <typename Policy>
+class BasicSimulator {
 public:
-    Simulator(std::vector<Task> tasks, tick_t horizon)
-        : tasks_(std::move(tasks)), horizon_(horizon)
+    BasicSimulator(std::vector<Task> tasks, tick_t horizon, SimEngine engine = SimEngine::Tick)
+        : tasks_(std::move(tasks)), horizon_(horizon), engine_(engine)
     {
         for (auto& t : tasks_) t.validate();
+        table_.assign(tasks_);
         metrics_.init_from_tasks(tasks_, horizon_);
+        ready_.init_from_tasks(tasks_);
+    }
+
+    // Abilita il rilevamento dello stato stazionario (ignorato con traccia o timeline di
+    // debug, che richiedono tutti i tick, o se l'iperperiodo non è rappresentabile, e con
+    // StopConditions::miss_count > 1: l'N-esimo miss potrebbe cadere nei cicli estrapolati).
+    void set_steady_state(bool enabled) { steady_state_ = enabled; }
+
+    // Istogrammi per task (quantili di response time, lateness e ritardo di avvio) nelle
+    // run successive. Disattivati di default: costano ~15-20% del motore a eventi.
+    void set_histograms(bool enabled) { histograms_ = enabled; }
+
+    // Registra la timeline delle run successive su `trace` (nullptr = nessuna traccia).
+    // Con debug_timeline la run usa invece un recorder interno che stampa su std::cout.
+    void set_trace(TraceRecorder* trace) { trace_ = trace; }
+
+    // Tick di CPU addebitati a ogni context switch (0 = switch gratuiti).
+    void set_switch_overhead(tick_t ticks) {
+        if (ticks < 0) throw std::invalid_argument("Switch overhead must be >= 0");
+        switch_overhead_ = ticks;
+    }
+
+    // Condizioni di terminazione anticipata delle run successive (vedi sopra).
+    void set_stop_conditions(const StopConditions& stop) {
+        stop.validate();
+        stop_ = stop;
     }
 
+    // Scorciatoia per StopConditions::first_miss.
+    void set_stop_on_deadline_miss(bool enabled) { stop_.first_miss = enabled; }
+
+    // Deadline del primo miss rilevato con condizioni di stop attive (no_tick se nessuno).
+    tick_t first_miss_tick() const { return first_miss_; }
+
     void run(bool debug_timeline = false, bool print_input = true, bool print_summary = true) {
         reset();
 
+        // Timeline di debug: record resi come testo a blocchi, non una stampa per tick.
+        std::optional<TimelineTextRenderer> text;
+        std::optional<TraceRecorder> timeline;
+        TraceRecorder* const user_trace = trace_;
+        if (debug_timeline) {
+            text.emplace(std::cout, table_.id);
+            timeline.emplace([&](const TraceRecord* r, std::size_t n) { text->consume(r, n); });
+            trace_ = &*timeline;
+        }
+
+        if (steady_state_ && trace_ == nullptr && stop_.miss_count <= 1) init_steady_state();
+        if (trace_) trace_->begin(tasks_, horizon_);
+
         if (print_input) {
             print_taskset(std::cout);
-            std::cout << "Policy: Fixed Priority Preemptive (FPP)\n";
+            std::cout << "Policy: " << Policy::description << "\n";
             std::cout << "Horizon: " << horizon_ << " ticks (1 tick = 1 ms)\n\n";
         }
 
-        for (tick_t t = 0; t < horizon_; ++t) {
-
-            // 1) Release nuovi job
-            for (std::int32_t ti = 0; ti < static_cast<std::int32_t>(tasks_.size()); ++ti) {
-                const auto& task = tasks_[ti];
-                if (task.releases_at(t)) {
-                    Job j = Job::from_task(task, ti, t, job_counter_[ti]++);
-                    jobs_.push_back(j);
-                    metrics_.per_task[ti].on_job_released();
-                }
+        try {
+            if (engine_ == SimEngine::Event) {
+                run_event_driven();
+            } else {
+                run_tick_loop();
             }
+            if (trace_) trace_->end();
+        } catch (...) {
+            trace_ = user_trace;
+            throw;
+        }
+        trace_ = user_trace;
 
-            // 2) Selezione job (FPP) e 3) esecuzione
-            int idx = SchedulerFPP::select_job(jobs_, tasks_, t);
-
-            if (idx >= 0) {
-                Job& running = jobs_[idx];
-                running.execute_one_tick(t);
-                metrics_.busy_ticks++;
-
-                if (running.finish_time.has_value()) {
-                    metrics_.per_task[running.task_index].on_job_completed(running);
-                }
-
-                if (debug_timeline) {
-                    print_timeline_line(std::cout, t, running);
-                }
-            } else {
-                if (debug_timeline) {
-                    std::cout << "t=" << std::setw(4) << t << "  IDLE\n";
+        if (stop_enabled_ && first_miss_ == no_tick) {
+            for (const Job& j : jobs_.live_jobs()) {
+                if (j.abs_deadline <= end_ && (first_miss_ == no_tick || j.abs_deadline < first_miss_)) {
+                    first_miss_ = j.abs_deadline;
                 }
             }
         }
 
         if (debug_timeline) {
+            text->flush();
             int count = 0;
-            for (const auto& j : jobs_) {
-                if (!j.is_completed()) {
-                    if (count == 0) {
-                        std::cout << "\nUnfinished jobs at end of horizon:\n";
-                    }
-                    std::cout << "  " << j.to_string() << "\n";
-                    count++;
+            for (const Job& j : jobs_.live_jobs()) {
+                if (count == 0) {
+                    std::cout << "\nUnfinished jobs at end of horizon:\n";
                 }
+                std::cout << "  " << j.to_string() << "\n";
+                count++;
             }
         }
 
+        if (stop_reason_ != StopReason::None) {
+            metrics_.stop_tick = end_;
+            metrics_.stop_reason = stop_reason_;
+        }
+        metrics_.peak_live_jobs = static_cast<std::int64_t>(jobs_.peak_live());
+        metrics_.peak_job_bytes = static_cast<std::int64_t>(jobs_.allocated_bytes());
         metrics_.finalize();
 
         if (print_summary) {
@@ -96,9 +191,325 @@ public:
 private:
     void reset() {
         jobs_.clear();
+        ready_.clear();
+        releases_.init_from_tasks(tasks_);
         job_counter_.assign(tasks_.size(), 0);
 
-        metrics_.init_from_tasks(tasks_, horizon_);
+        metrics_.init_from_tasks(tasks_, horizon_, 1, histograms_);
+
+        end_ = horizon_;
+        next_checkpoint_ = std::numeric_limits<tick_t>::max();
+        snapshot_.valid = false;
+
+        last_slot_ = no_slot;
+        overhead_left_ = 0;
+
+        stop_enabled_ = stop_.any();
+        stop_task_index_ = -1;
+        for (std::size_t i = 0; i < tasks_.size() && stop_.miss_task_id >= 0; ++i) {
+            if (table_.id[i] == stop_.miss_task_id) {
+                stop_task_index_ = static_cast<std::int32_t>(i);
+                break;
+            }
+        }
+        stop_reason_ = StopReason::None;
+        misses_seen_ = 0;
+        overdue_.assign(tasks_.size(), 0);
+        first_miss_ = no_tick;
+    }
+
+    // Primo checkpoint in O_max; serve almeno un ciclo intero dopo il secondo checkpoint.
+    void init_steady_state() {
+        try {
+            cycle_ = hyperperiod(tasks_);
+        } catch (const std::overflow_error&) {
+            return;
+        }
+        if (cycle_ <= 0) return;
+
+        tick_t max_offset = 0;
+        for (const auto& t : tasks_) max_offset = std::max(max_offset, t.offset);
+
+        if (max_offset < end_ && (end_ - max_offset) / cycle_ >= 2) {
+            next_checkpoint_ = max_offset;
+        }
+    }
+
+    // Job pendente relativo al checkpoint: identifica lo stato dello scheduler
+    // (l'ordine dei job in coda deriva da rilascio e indice del task).
+    struct PendingJob {
+        std::int32_t task_index;
+        tick_t release;
+        tick_t remaining;
+        tick_t start;
+
+        bool operator==(const PendingJob&) const = default;
+    };
+
+    struct SteadyStateSnapshot {
+        bool valid = false;
+        std::vector<PendingJob> pending;
+        PendingJob last{-1, 0, 0, 0};   // ultimo job eseguito e non terminato
+        tick_t overhead_left = 0;
+        tick_t busy_ticks = 0;
+        std::int64_t context_switches = 0;
+        std::int64_t preemptions = 0;
+        tick_t overhead_ticks = 0;
+        std::vector<TaskMetrics> per_task;
+    };
+
+    PendingJob relative(const Job& j, tick_t t) const {
+        return {j.task_index, j.release_time - t, j.remaining_time,
+                j.has_started() ? j.start_time - t : no_tick};
+    }
+
+    void steady_state_checkpoint(tick_t t) {
+        SteadyStateSnapshot snap;
+        snap.valid = true;
+        for (const Job& j : jobs_.live_jobs()) snap.pending.push_back(relative(j, t));
+        if (last_slot_ != no_slot) snap.last = relative(jobs_.get(last_slot_), t);
+        snap.overhead_left = overhead_left_;
+        snap.busy_ticks = metrics_.busy_ticks;
+        snap.context_switches = metrics_.context_switches;
+        snap.preemptions = metrics_.preemptions_total;
+        snap.overhead_ticks = metrics_.switch_overhead_ticks;
+        snap.per_task = metrics_.per_task;
+
+        if (snapshot_.valid && snap.pending == snapshot_.pending && snap.last == snapshot_.last &&
+            snap.overhead_left == snapshot_.overhead_left) {
+            extrapolate_cycles((end_ - t) / cycle_);
+            next_checkpoint_ = std::numeric_limits<tick_t>::max();
+            return;
+        }
+
+        snapshot_ = std::move(snap);
+        next_checkpoint_ = ((end_ - t) / cycle_ >= 2) ? t + cycle_ : std::numeric_limits<tick_t>::max();
+    }
+
+    // L'ultimo ciclo (dallo snapshot precedente a ora) si ripete `cycles` volte:
+    // le metriche additive crescono del suo contributo, la simulazione termina prima.
+    void extrapolate_cycles(tick_t cycles) {
+        if (cycles <= 0) return;
+
+        metrics_.busy_ticks += cycles * (metrics_.busy_ticks - snapshot_.busy_ticks);
+        metrics_.context_switches += cycles * (metrics_.context_switches - snapshot_.context_switches);
+        metrics_.preemptions_total += cycles * (metrics_.preemptions_total - snapshot_.preemptions);
+        metrics_.switch_overhead_ticks += cycles * (metrics_.switch_overhead_ticks - snapshot_.overhead_ticks);
+        for (size_t i = 0; i < tasks_.size(); ++i) {
+            TaskMetrics& cur = metrics_.per_task[i];
+            const TaskMetrics& prev = snapshot_.per_task[i];
+            const std::int64_t released = cur.jobs_released - prev.jobs_released;
+
+            cur.jobs_released += cycles * released;
+            cur.jobs_completed += cycles * (cur.jobs_completed - prev.jobs_completed);
+            cur.deadline_miss += cycles * (cur.deadline_miss - prev.deadline_miss);
+            cur.rt_sum += cycles * (cur.rt_sum - prev.rt_sum);
+            cur.lateness_sum += cycles * (cur.lateness_sum - prev.lateness_sum);
+            cur.context_switches += cycles * (cur.context_switches - prev.context_switches);
+            cur.preemptions += cycles * (cur.preemptions - prev.preemptions);
+            cur.rt_hist.repeat_since(prev.rt_hist, cycles);
+            cur.late_hist.repeat_since(prev.late_hist, cycles);
+            cur.start_hist.repeat_since(prev.start_hist, cycles);
+            job_counter_[i] += static_cast<int>(cycles * released);
+        }
+
+        end_ -= cycles * cycle_;
+        metrics_.extrapolated_ticks = cycles * cycle_;
+    }
+
+    // I parametri vengono letti dalla TaskTable (task già validati nel costruttore).
+    void release_job(std::int32_t ti, tick_t t) {
+        if (stop_enabled_) check_overdue(ti, t);
+
+        Job j;
+        j.task_id = table_.id[ti];
+        j.task_index = ti;
+        j.job_index = job_counter_[ti]++;
+        j.release_time = t;
+        j.abs_deadline = t + table_.deadline[ti];
+        j.remaining_time = table_.wcet[ti];
+
+        const std::size_t slot = jobs_.acquire(j);
+        ready_.push(ti, slot, j);
+        metrics_.per_task[ti].on_job_released();
+        if (trace_) trace_->release(t, ti, j.job_index, j.abs_deadline);
+
+        if (stop_.max_backlog > 0 && static_cast<std::int64_t>(jobs_.live()) > stop_.max_backlog) {
+            stop_at(t, StopReason::Backlog);
+        }
+    }
+
+    // Registra l'esecuzione del job in `slot` per `ticks` tick da `t` (prima di eseguirlo).
+    void trace_run(std::size_t slot, tick_t t, tick_t ticks) {
+        const Job j = jobs_.get(slot);
+        if (!j.has_started()) trace_->start(t, j.task_index, j.job_index);
+        trace_->run(t, ticks, j.task_index, j.job_index, j.remaining_time);
+    }
+
+    // Il job in esecuzione è sempre in testa alla ready queue: al completamento
+    // esce dalla coda e il suo slot torna al pool.
+    void complete_running(std::size_t slot) {
+        last_slot_ = no_slot;
+        const Job running = jobs_.get(slot);
+        metrics_.per_task[running.task_index].on_job_completed(running);
+        if (stop_enabled_ && running.finish_time > running.abs_deadline) {
+            // I job in ritardo già contati al rilascio sono i più vecchi: completano per primi.
+            if (overdue_[running.task_index] > 0) overdue_[running.task_index]--;
+            else on_miss(running.task_index, running.abs_deadline, 1, running.finish_time);
+        }
+        if (trace_) trace_->finish(running.finish_time, running.task_index, running.job_index, running.abs_deadline);
+        ready_.pop();
+        jobs_.release(slot);
+    }
+
+    // Il job in `slot` va in esecuzione al posto di last_slot_: conta switch e preemption
+    // e avvia l'eventuale overhead. Vero se il job può già eseguire (nessun overhead).
+    bool switch_to(std::size_t slot, tick_t t) {
+        const std::int32_t ti = jobs_.task_index(slot);
+        metrics_.context_switches++;
+        metrics_.per_task[ti].context_switches++;
+        if (last_slot_ != no_slot) {
+            metrics_.preemptions_total++;
+            metrics_.per_task[jobs_.task_index(last_slot_)].preemptions++;
+        }
+        last_slot_ = slot;
+        overhead_left_ = switch_overhead_;
+        if (trace_ && overhead_left_ > 0) trace_dispatch(slot, t);
+        return overhead_left_ == 0;
+    }
+
+    // Overhead di switch in corso: la CPU è occupata ma nessun job avanza.
+    void charge_overhead(tick_t t, tick_t ticks) {
+        overhead_left_ -= ticks;
+        metrics_.busy_ticks += ticks;
+        metrics_.switch_overhead_ticks += ticks;
+        if (trace_) trace_->overhead(t, ticks, jobs_.task_index(last_slot_), jobs_.get(last_slot_).job_index);
+    }
+
+    // Al rilascio di un job del task `ti` in `t` tutti i suoi job ancora pendenti hanno
+    // superato la deadline (D <= T): conta quelli non ancora contati (i più recenti).
+    void check_overdue(std::int32_t ti, tick_t t) {
+        const TaskMetrics& tm = metrics_.per_task[ti];
+        const std::int64_t pending = tm.jobs_released - tm.jobs_completed;
+        if (pending <= overdue_[ti]) return;
+
+        // Il più vecchio dei nuovi job in ritardo è stato rilasciato (pending - overdue) periodi fa.
+        const std::int64_t fresh = pending - overdue_[ti];
+        overdue_[ti] = pending;
+        on_miss(ti, t - fresh * table_.period[ti] + table_.deadline[ti], fresh, t);
+    }
+
+    // `count` miss del task `ti` (il primo alla deadline `deadline`) rilevati in `now`.
+    void on_miss(std::int32_t ti, tick_t deadline, std::int64_t count, tick_t now) {
+        first_miss_ = (first_miss_ == no_tick) ? deadline : std::min(first_miss_, deadline);
+        misses_seen_ += count;
+        if (stop_.first_miss) stop_at(now, StopReason::FirstMiss);
+        else if (ti == stop_task_index_) stop_at(now, StopReason::TaskMiss);
+        else if (stop_.miss_count > 0 && misses_seen_ >= stop_.miss_count) stop_at(now, StopReason::MissCount);
+    }
+
+    // La simulazione termina in `now` (vale la prima condizione soddisfatta).
+    void stop_at(tick_t now, StopReason reason) {
+        if (stop_reason_ != StopReason::None) return;
+        stop_reason_ = reason;
+        end_ = std::min(end_, now);
+    }
+
+    void trace_dispatch(std::size_t slot, tick_t t) {
+        const Job j = jobs_.get(slot);
+        trace_->dispatch(t, j.task_index, j.job_index);
+    }
+
+    void run_tick_loop() {
+        for (tick_t t = 0; t < end_; ++t) {
+            if (t == next_checkpoint_) steady_state_checkpoint(t);
+            if (t >= end_) break;
+
+            // 1) Release nuovi job (solo nei tick in cui il calendario prevede un rilascio)
+            if (t == releases_.next_time()) {
+                releases_.release_due(t, [&](std::int32_t ti) { release_job(ti, t); });
+                if (t >= end_) break;
+            }
+
+            if (overhead_left_ > 0) {
+                charge_overhead(t, 1);
+                continue;
+            }
+
+            // 2) Selezione job e 3) esecuzione
+            int idx = Scheduler<Policy>::select_job(ready_);
+
+            if (idx >= 0) {
+                if (static_cast<std::size_t>(idx) != last_slot_ && !switch_to(idx, t)) {
+                    charge_overhead(t, 1);
+                    continue;
+                }
+                if (trace_) trace_run(idx, t, 1);
+                jobs_.execute_one_tick(idx, t);
+                metrics_.busy_ticks++;
+
+                if (jobs_.is_finished(idx)) {
+                    complete_running(idx);
+                } else {
+                    ready_.on_executed(1);
+                }
+            } else if (trace_) {
+                trace_->idle(t, 1);
+            }
+        }
+    }
+
+    // Motore a eventi discreti: tra due eventi consecutivi (rilascio, completamento del
+    // job in esecuzione, fine horizon) lo stato dello scheduler non cambia, quindi il job
+    // selezionato viene eseguito in blocco. Con priorità fisse ed EDF una preemption può
+    // avvenire solo su un rilascio; con LLF la slice è limitata anche da stable_ticks().
+    void run_event_driven() {
+        tick_t t = 0;
+        while (t < end_) {
+            if (t == next_checkpoint_) steady_state_checkpoint(t);
+            if (t >= end_) break;
+
+            // 1) Release dei job con rilascio in t
+            if (t == releases_.next_time()) {
+                releases_.release_due(t, [&](std::int32_t ti) { release_job(ti, t); });
+                if (t >= end_) break;
+            }
+            const tick_t next_event = std::min({end_, releases_.next_time(), next_checkpoint_});
+
+            // Overhead di switch fino al suo termine o al prossimo evento
+            if (overhead_left_ > 0) {
+                const tick_t span = std::min(overhead_left_, next_event - t);
+                charge_overhead(t, span);
+                t += span;
+                continue;
+            }
+
+            // 2) Selezione job
+            const int idx = Scheduler<Policy>::select_job(ready_);
+
+            if (idx < 0) {
+                if (trace_) trace_->idle(t, next_event - t);
+                t = next_event;
+                continue;
+            }
+
+            if (static_cast<std::size_t>(idx) != last_slot_ && !switch_to(idx, t)) continue;
+
+            // 3) Esecuzione fino al prossimo evento
+            const tick_t slice = std::min({jobs_.remaining(idx), next_event - t, ready_.stable_ticks()});
+
+            if (trace_) trace_run(idx, t, slice);
+            jobs_.execute_for(idx, t, slice);
+            metrics_.busy_ticks += slice;
+
+            if (jobs_.is_finished(idx)) {
+                complete_running(idx);
+            } else {
+                ready_.on_executed(slice);
+            }
+
+            t += slice;
+        }
     }
 
 
@@ -130,29 +541,45 @@ private:
         os << "\n";
     }
 
-    void print_timeline_line(std::ostream& os, tick_t now, const Job& j) const {
-        os << "t=" << std::setw(4) << now
-           << "  RUN  task_id=" << std::setw(3) << j.task_id
-           << "  job=" << std::setw(3) << j.job_index
-           << "  rem->" << std::setw(3) << j.remaining_time;
-
-        if (j.finish_time.has_value() && *j.finish_time == now + 1) {
-            tick_t late = *j.finish_time - j.abs_deadline;
-            os << "  FINISH@" << *j.finish_time
-               << "  dl=" << j.abs_deadline
-               << "  late=" << (late > 0 ? late : 0);
-        }
-        os << "\n";
-    }
-
 private:
     std::vector<Task> tasks_;
-    std::vector<Job> jobs_;
+    TaskTable table_;       // parametri dei task in layout SoA (loop caldo)
+    JobPool jobs_;          // slot riciclati: memoria limitata dai job vivi
+    typename Policy::ReadyQueue ready_;     // solo job rilasciati e non completati
+    ReleaseCalendar releases_;
     tick_t horizon_;
+    SimEngine engine_;
 
     std::vector<int> job_counter_;
 
+    bool steady_state_ = false;
+    tick_t end_ = 0;            // horizon meno i cicli estrapolati
+    tick_t cycle_ = 0;          // iperperiodo
+    tick_t next_checkpoint_ = std::numeric_limits<tick_t>::max();
+    SteadyStateSnapshot snapshot_;
+
     SimulationMetrics metrics_;
+    bool histograms_ = false;
+
+    TraceRecorder* trace_ = nullptr;
+
+    // Context switch: ultimo job eseguito e non terminato, overhead residuo dello switch.
+    static constexpr std::size_t no_slot = std::numeric_limits<std::size_t>::max();
+    std::size_t last_slot_ = no_slot;
+    tick_t switch_overhead_ = 0;
+    tick_t overhead_left_ = 0;
+
+    // Terminazione anticipata: job in ritardo già contati e ancora pendenti per task,
+    // miss rilevati, indice del task osservato (-1 se assente dal task set).
+    StopConditions stop_;
+    bool stop_enabled_ = false;
+    std::int32_t stop_task_index_ = -1;
+    StopReason stop_reason_ = StopReason::None;
+    std::int64_t misses_seen_ = 0;
+    std::vector<std::int64_t> overdue_;
+    tick_t first_miss_ = no_tick;
 };
 
+using Simulator = BasicSimulator<PolicyFPP>;
+
 } // namespace rt
@@ -2,12 +2,14 @@
 // Created by Francesco on 17/02/2026.
 //
 // Definizione della struttura dati per rappresentare un task periodico.
+// TaskTable: stessi parametri in layout structure-of-arrays, per il loop caldo del simulatore.
 
 #pragma once
 
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace rt {
 
@@ -69,4 +71,42 @@ struct Task {
     }
 };
 
+// Utilizzazione del task set: somma di C/T.
+inline double total_utilization(const std::vector<Task>& tasks) {
+    double u = 0.0;
+    for (const auto& t : tasks) u += static_cast<double>(t.wcet) / static_cast<double>(t.period);
+    return u;
+}
+
+// Parametri dei task in array contigui (un array per campo, indice = task_index).
+// Task resta l'API pubblica; la tabella è costruita una volta dai task già validati.
+struct TaskTable {
+    std::vector<id_t> id;
+    std::vector<tick_t> period;
+    std::vector<tick_t> deadline;
+    std::vector<tick_t> wcet;
+    std::vector<prio_t> priority;
+    std::vector<tick_t> offset;
+
+    void assign(const std::vector<Task>& tasks) {
+        const std::size_t n = tasks.size();
+        id.resize(n);
+        period.resize(n);
+        deadline.resize(n);
+        wcet.resize(n);
+        priority.resize(n);
+        offset.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            id[i] = tasks[i].id;
+            period[i] = tasks[i].period;
+            deadline[i] = tasks[i].deadline;
+            wcet[i] = tasks[i].wcet;
+            priority[i] = tasks[i].priority;
+            offset[i] = tasks[i].offset;
+        }
+    }
+
+    std::size_t size() const { return id.size(); }
+};
+
 } // namespace rt
@@ -2,10 +2,19 @@
 // Created by Francesco on 17/02/2026.
 //
 // Generatore di task set periodici con utilizzo target.
-// - periodi uniformi in [Tmin, Tmax]
+// - periodi in [Tmin, Tmax] secondo PeriodMode:
+//   Uniform:    uniformi (iperperiodo spesso enorme)
+//   Divisors:   uniformi tra i numeri 2^a 3^b 5^c 7^d dell'intervallo
+//   LogUniform: log-uniformi, arrotondati al più vicino numero 2^a 3^b 5^c 7^d
+//   Con Divisors/LogUniform e max_hyperperiod > 0 l'iperperiodo è garantito <= max_hyperperiod
 // - deadline = period (implicit deadline)
-// - WCET calcolato per raggiungere utilizzo target
+// - WCET calcolato per raggiungere utilizzo target, secondo UtilizationMode:
+//   Normalized:      estrazioni uniformi normalizzate (distribuzione distorta), C in [1, T-1] (richiede Tmin >= 2)
+//   UUniFast:        UUniFast (Bini & Buttazzo), utilizzi uniformi sul simplesso, C = round(u*T)
+//   UUniFastDiscard: come UUniFast, scartando i vettori con qualche u_i > 1 (target > 1)
 // - priorità assegnata secondo Rate Monotonic
+// generate_batch: migliaia di task set per chiamata in un buffer structure-of-arrays
+// (TaskSetBatch), con RNG counter-based: il task set k dipende solo da (seed, k).
 
 #pragma once
 
@@ -13,17 +22,70 @@
 #include <random>
 #include <algorithm>
 #include <stdexcept>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <sstream>
+#include <iomanip>
 
 #include "task.hpp"
+#include "time_utils.hpp"
+#include "counter_rng.hpp"
 
 namespace rt {
 
+enum class PeriodMode {
+    Uniform,
+    Divisors,
+    LogUniform
+};
+
+enum class UtilizationMode {
+    Normalized,
+    UUniFast,
+    UUniFastDiscard
+};
+
 struct GeneratorConfig {
     std::int32_t n_tasks = 5;
     tick_t Tmin = 10;
     tick_t Tmax = 100;
     double utilization_target = 0.75;
     std::uint32_t seed = 1;
+
+    PeriodMode period_mode = PeriodMode::Uniform;
+
+    // Solo Divisors/LogUniform: limite all'iperperiodo (0 = nessun limite).
+    tick_t max_hyperperiod = 0;
+
+    UtilizationMode utilization_mode = UtilizationMode::Normalized;
+};
+
+// Task set generati da generate_batch, in layout structure-of-arrays:
+// il task i del set s è all'indice s * n_tasks + i di ciascun array.
+// deadline = period e offset = 0 (come in generate).
+struct TaskSetBatch {
+    std::int32_t n_tasks = 0;
+    std::size_t n_sets = 0;
+
+    std::vector<tick_t> periods;
+    std::vector<tick_t> wcets;
+    std::vector<prio_t> priorities;
+
+    std::vector<Task> task_set(std::size_t s) const {
+        std::vector<Task> tasks(static_cast<std::size_t>(n_tasks));
+        const std::size_t base = s * static_cast<std::size_t>(n_tasks);
+        for (std::int32_t i = 0; i < n_tasks; ++i) {
+            Task& t = tasks[i];
+            t.id = i;
+            t.period = periods[base + i];
+            t.deadline = t.period;
+            t.wcet = wcets[base + i];
+            t.priority = priorities[base + i];
+            t.offset = 0;
+        }
+        return tasks;
+    }
 };
 
 class TaskSetGenerator {
@@ -31,28 +93,47 @@ public:
     static std::vector<Task> generate(const GeneratorConfig& cfg) {
         if (cfg.n_tasks <= 0)
             throw std::invalid_argument("n_tasks must be > 0");
+        if (cfg.utilization_mode == UtilizationMode::Normalized && cfg.Tmin < 2)
+            throw std::invalid_argument("Normalized utilization needs Tmin >= 2 (C in [1, T-1])");
 
         std::mt19937 rng(cfg.seed);
-        std::uniform_int_distribution<tick_t> period_dist(cfg.Tmin, cfg.Tmax);
 
-        std::vector<tick_t> periods(cfg.n_tasks);
-        for (int i = 0; i < cfg.n_tasks; ++i) {
-            periods[i] = period_dist(rng);
+        std::vector<tick_t> periods;
+        if (cfg.period_mode == PeriodMode::Uniform) {
+            std::uniform_int_distribution<tick_t> period_dist(cfg.Tmin, cfg.Tmax);
+            periods.resize(cfg.n_tasks);
+            for (int i = 0; i < cfg.n_tasks; ++i) {
+                periods[i] = period_dist(rng);
+            }
+        } else {
+            periods = smooth_periods(cfg, rng);
         }
 
-        // Distribuzione uniforme semplice delle frazioni di utilizzo
-        std::uniform_real_distribution<double> u_dist(0.0, 1.0);
-
         std::vector<double> u(cfg.n_tasks);
-        double sum_u = 0.0;
-        for (int i = 0; i < cfg.n_tasks; ++i) {
-            u[i] = u_dist(rng);
-            sum_u += u[i];
-        }
+        if (cfg.utilization_mode == UtilizationMode::Normalized) {
+            // Distribuzione uniforme semplice delle frazioni di utilizzo
+            std::uniform_real_distribution<double> u_dist(0.0, 1.0);
 
-        // Normalizza per ottenere somma = utilization_target
-        for (int i = 0; i < cfg.n_tasks; ++i) {
-            u[i] = (u[i] / sum_u) * cfg.utilization_target;
+            double sum_u = 0.0;
+            for (int i = 0; i < cfg.n_tasks; ++i) {
+                u[i] = u_dist(rng);
+                sum_u += u[i];
+            }
+
+            // Normalizza per ottenere somma = utilization_target
+            for (int i = 0; i < cfg.n_tasks; ++i) {
+                u[i] = (u[i] / sum_u) * cfg.utilization_target;
+            }
+        } else {
+            std::uniform_real_distribution<double> r_dist(0.0, 1.0);
+            for (int attempt = 0;; ++attempt) {
+                if (uunifast(u.data(), cfg.n_tasks, cfg.utilization_target, [&] { return r_dist(rng); }) ||
+                    cfg.utilization_mode == UtilizationMode::UUniFast) {
+                    break;
+                }
+                if (attempt + 1 >= max_discard_attempts)
+                    throw std::runtime_error("UUniFast-discard: too many rejected utilization vectors");
+            }
         }
 
         std::vector<Task> tasks;
@@ -60,10 +141,15 @@ public:
 
         for (int i = 0; i < cfg.n_tasks; ++i) {
             tick_t T = periods[i];
-            tick_t C = static_cast<tick_t>(u[i] * T);
+            tick_t C;
 
-            if (C < 1) C = 1;
-            if (C >= T) C = T - 1;
+            if (cfg.utilization_mode == UtilizationMode::Normalized) {
+                C = static_cast<tick_t>(u[i] * static_cast<double>(T));
+                if (C < 1) C = 1;
+                if (C >= T) C = T - 1;
+            } else {
+                C = wcet_for(u[i], T);
+            }
 
             Task t;
             t.id = i;
@@ -90,6 +176,288 @@ public:
 
         return tasks;
     }
+
+    // Genera i task set di indice [first_set, first_set + count): il set k usa lo stream
+    // CounterRng(cfg.seed, k), quindi il risultato non dipende da come la campagna è
+    // suddivisa tra chiamate o thread. Periodi Uniform e UUniFast sono calcolati con loop
+    // su tutti i set (task-major, vettorizzabili dal compilatore); i periodi Divisors /
+    // LogUniform e i ritentativi di UUniFast-discard procedono per set.
+    // Nota: stessi parametri ma sequenza diversa da generate() (che usa std::mt19937).
+    static TaskSetBatch generate_batch(const GeneratorConfig& cfg, std::uint64_t first_set, std::size_t count) {
+        if (cfg.n_tasks <= 0)
+            throw std::invalid_argument("n_tasks must be > 0");
+        if (cfg.utilization_mode == UtilizationMode::Normalized && cfg.Tmin < 2)
+            throw std::invalid_argument("Normalized utilization needs Tmin >= 2 (C in [1, T-1])");
+
+        const std::size_t n = static_cast<std::size_t>(cfg.n_tasks);
+        TaskSetBatch out;
+        out.n_tasks = cfg.n_tasks;
+        out.n_sets = count;
+        out.periods.resize(count * n);
+        out.wcets.resize(count * n);
+        out.priorities.resize(count * n);
+
+        std::vector<CounterRng> rngs;
+        rngs.reserve(count);
+        for (std::size_t s = 0; s < count; ++s) rngs.emplace_back(cfg.seed, first_set + s);
+
+        // Contatori dello stream: [0, n) periodi, poi n valori per ogni tentativo di utilizzi.
+        // I modi Divisors/LogUniform consumano lo stream dal contatore stream_smooth.
+        const std::uint64_t stream_util = n;
+        const std::uint64_t stream_smooth = std::uint64_t{1} << 40;
+
+        // --- Periodi (task-major: period_tm[i * count + s]) ---
+        std::vector<tick_t> period_tm(count * n);
+        if (cfg.period_mode == PeriodMode::Uniform) {
+            const auto range = static_cast<std::uint64_t>(cfg.Tmax - cfg.Tmin + 1);
+            for (std::size_t i = 0; i < n; ++i) {
+                tick_t* dst = &period_tm[i * count];
+                for (std::size_t s = 0; s < count; ++s) {
+                    dst[s] = cfg.Tmin + static_cast<tick_t>(CounterRng::to_bounded(rngs[s].at(i), range));
+                }
+            }
+        } else {
+            for (std::size_t s = 0; s < count; ++s) {
+                CounterRng r = rngs[s];
+                r.seek(stream_smooth);
+                const std::vector<tick_t> p = smooth_periods(cfg, r);
+                for (std::size_t i = 0; i < n; ++i) period_tm[i * count + s] = p[i];
+            }
+        }
+
+        // --- Utilizzi (task-major) ---
+        std::vector<double> u_tm(count * n);
+        if (cfg.utilization_mode == UtilizationMode::Normalized) {
+            std::vector<double> sum(count, 0.0);
+            for (std::size_t i = 0; i < n; ++i) {
+                double* dst = &u_tm[i * count];
+                for (std::size_t s = 0; s < count; ++s) {
+                    dst[s] = CounterRng::to_unit(rngs[s].at(stream_util + i));
+                    sum[s] += dst[s];
+                }
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                double* dst = &u_tm[i * count];
+                for (std::size_t s = 0; s < count; ++s) dst[s] = dst[s] / sum[s] * cfg.utilization_target;
+            }
+        } else {
+            // UUniFast vettoriale sui set: sum_{i+1} = sum_i * r^(1/(n-1-i)), u_i = sum_i - sum_{i+1}
+            std::vector<double> rest(count, cfg.utilization_target);
+            for (std::size_t i = 0; i + 1 < n; ++i) {
+                const double inv_exp = 1.0 / static_cast<double>(n - 1 - i);
+                double* dst = &u_tm[i * count];
+                for (std::size_t s = 0; s < count; ++s) {
+                    const double next = rest[s] * std::pow(CounterRng::to_unit(rngs[s].at(stream_util + i)), inv_exp);
+                    dst[s] = rest[s] - next;
+                    rest[s] = next;
+                }
+            }
+            std::copy(rest.begin(), rest.end(), u_tm.begin() + static_cast<std::ptrdiff_t>((n - 1) * count));
+
+            if (cfg.utilization_mode == UtilizationMode::UUniFastDiscard) {
+                std::vector<double> u(n);
+                for (std::size_t s = 0; s < count; ++s) {
+                    bool ok = true;
+                    for (std::size_t i = 0; i < n; ++i) ok = ok && u_tm[i * count + s] <= 1.0;
+                    for (int attempt = 1; !ok; ++attempt) {
+                        if (attempt >= max_discard_attempts)
+                            throw std::runtime_error("UUniFast-discard: too many rejected utilization vectors");
+                        std::uint64_t ctr = stream_util + static_cast<std::uint64_t>(attempt) * n;
+                        ok = uunifast(u.data(), cfg.n_tasks, cfg.utilization_target,
+                                      [&] { return CounterRng::to_unit(rngs[s].at(ctr++)); });
+                        for (std::size_t i = 0; i < n; ++i) u_tm[i * count + s] = u[i];
+                    }
+                }
+            }
+        }
+
+        // --- WCET e priorità RM (set-major) ---
+        std::vector<std::int32_t> order(n);
+        for (std::size_t s = 0; s < count; ++s) {
+            const std::size_t base = s * n;
+            for (std::size_t i = 0; i < n; ++i) {
+                const tick_t T = period_tm[i * count + s];
+                const double ui = u_tm[i * count + s];
+                out.periods[base + i] = T;
+                if (cfg.utilization_mode == UtilizationMode::Normalized) {
+                    out.wcets[base + i] = std::clamp<tick_t>(static_cast<tick_t>(ui * static_cast<double>(T)), 1, T - 1);
+                } else {
+                    out.wcets[base + i] = wcet_for(ui, T);
+                }
+            }
+
+            for (std::size_t i = 0; i < n; ++i) order[i] = static_cast<std::int32_t>(i);
+            std::stable_sort(order.begin(), order.end(), [&](std::int32_t a, std::int32_t b) {
+                return out.periods[base + a] < out.periods[base + b];
+            });
+            for (std::size_t prio = 0; prio < n; ++prio) {
+                out.priorities[base + order[prio]] = static_cast<prio_t>(prio);
+            }
+        }
+
+        return out;
+    }
+
+    // Numeri 7-smooth (2^a 3^b 5^c 7^d) in [lo, hi], in ordine crescente.
+    static std::vector<tick_t> smooth_numbers(tick_t lo, tick_t hi) {
+        std::vector<tick_t> out;
+        for (tick_t p2 = 1; p2 <= hi; p2 *= 2)
+            for (tick_t p3 = p2; p3 <= hi; p3 *= 3)
+                for (tick_t p5 = p3; p5 <= hi; p5 *= 5)
+                    for (tick_t p7 = p5; p7 <= hi; p7 *= 7) {
+                        if (p7 >= lo) out.push_back(p7);
+                        if (p7 > hi / 7) break;
+                    }
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+private:
+    static constexpr int max_discard_attempts = 1000;
+
+    // C = round(u * T) in [1, T]: l'utilizzo ottenuto si discosta dal target solo per arrotondamento.
+    static tick_t wcet_for(double u, tick_t T) {
+        return std::clamp<tick_t>(std::llround(u * static_cast<double>(T)), 1, T);
+    }
+
+    // UUniFast: n utilizzi con somma `total`, uniformi sul simplesso.
+    // Restituisce false se qualche u_i > 1 (vettore da scartare in UUniFast-discard).
+    template <typename Draw>
+    static bool uunifast(double* u, std::int32_t n, double total, Draw&& draw) {
+        double rest = total;
+        bool ok = true;
+        for (std::int32_t i = 0; i + 1 < n; ++i) {
+            const double next = rest * std::pow(draw(), 1.0 / static_cast<double>(n - 1 - i));
+            u[i] = rest - next;
+            rest = next;
+            ok = ok && u[i] <= 1.0;
+        }
+        u[n - 1] = rest;
+        return ok && rest <= 1.0;
+    }
+
+    // LCM(a, b) se non supera `bound`, altrimenti 0.
+    static tick_t lcm_within(tick_t a, tick_t b, tick_t bound) {
+        const tick_t a_div_g = a / gcd_tick(a, b);
+        if (a_div_g > bound / b) return 0;
+        return a_div_g * b;
+    }
+
+    // Periodi estratti uno alla volta tra i candidati compatibili: un candidato è ammesso
+    // se l'LCM corrente resta entro il limite. I divisori dell'LCM corrente sono sempre
+    // ammessi (almeno il primo periodo), quindi l'estrazione non fallisce mai.
+    template <typename Rng>
+    static std::vector<tick_t> smooth_periods(const GeneratorConfig& cfg, Rng& rng) {
+        const tick_t bound = (cfg.max_hyperperiod > 0) ? cfg.max_hyperperiod
+                                                       : std::numeric_limits<tick_t>::max();
+        const std::vector<tick_t> candidates = smooth_numbers(cfg.Tmin, std::min(cfg.Tmax, bound));
+        if (candidates.empty())
+            throw std::invalid_argument("no period of the form 2^a 3^b 5^c 7^d in [Tmin, min(Tmax, max_hyperperiod)]");
+
+        std::uniform_real_distribution<double> log_dist(
+            std::log(static_cast<double>(candidates.front())),
+            std::log(static_cast<double>(candidates.back())));
+
+        std::vector<tick_t> periods(cfg.n_tasks);
+        std::vector<tick_t> allowed;
+        allowed.reserve(candidates.size());
+        tick_t lcm = 1;
+
+        for (int i = 0; i < cfg.n_tasks; ++i) {
+            allowed.clear();
+            for (tick_t c : candidates) {
+                if (lcm_within(lcm, c, bound) != 0) allowed.push_back(c);
+            }
+
+            tick_t T;
+            if (cfg.period_mode == PeriodMode::LogUniform) {
+                // Candidato ammesso più vicino (in scala logaritmica) al valore estratto.
+                const double x = log_dist(rng);
+                T = allowed.front();
+                double best = std::abs(std::log(static_cast<double>(T)) - x);
+                for (tick_t c : allowed) {
+                    const double d = std::abs(std::log(static_cast<double>(c)) - x);
+                    if (d < best) {
+                        best = d;
+                        T = c;
+                    }
+                }
+            } else {
+                std::uniform_int_distribution<std::size_t> pick(0, allowed.size() - 1);
+                T = allowed[pick(rng)];
+            }
+
+            periods[i] = T;
+            lcm = lcm_within(lcm, T, bound);
+        }
+
+        return periods;
+    }
+};
+
+// Parametri del generatore escluso il seed, in forma testuale stabile (double a
+// precisione piena): identificano le sorgenti nel journal di checkpoint.
+inline std::string describe_generator(const GeneratorConfig& g) {
+    std::ostringstream os;
+    os << "n_tasks=" << g.n_tasks << " t=" << g.Tmin << ".." << g.Tmax
+       << " u=" << std::setprecision(17) << g.utilization_target
+       << " period_mode=" << static_cast<int>(g.period_mode)
+       << " max_hyperperiod=" << g.max_hyperperiod
+       << " utilization_mode=" << static_cast<int>(g.utilization_mode);
+    return os.str();
+}
+
+// Sorgente lazy di task set per BatchRunner::run_stream: il task set i-esimo viene
+// generato solo quando richiesto, con seed = first_seed + i (riproducibile e
+// indipendente dall'ordine in cui i worker lo richiedono).
+class SeedRangeSource {
+public:
+    SeedRangeSource(const GeneratorConfig& base, std::uint32_t first_seed, std::uint64_t count)
+        : base_(base), first_seed_(first_seed), count_(count) {}
+
+    std::uint64_t size() const { return count_; }
+
+    std::vector<Task> make(std::uint64_t i) const {
+        GeneratorConfig cfg = base_;
+        cfg.seed = first_seed_ + static_cast<std::uint32_t>(i);
+        return TaskSetGenerator::generate(cfg);
+    }
+
+    // Identità della sorgente (BatchConfig::campaign_fingerprint).
+    std::string describe() const {
+        return "seed_range " + describe_generator(base_) + " first_seed=" + std::to_string(first_seed_) +
+               " count=" + std::to_string(count_);
+    }
+
+private:
+    GeneratorConfig base_;
+    std::uint32_t first_seed_;
+    std::uint64_t count_;
+};
+
+// Sorgente lazy per run_stream con lo stesso RNG counter-based di generate_batch:
+// make(i) coincide con il task set i di generate_batch(base, first_set, ...).
+class CounterSetSource {
+public:
+    CounterSetSource(const GeneratorConfig& base, std::uint64_t first_set, std::uint64_t count)
+        : base_(base), first_set_(first_set), count_(count) {}
+
+    std::uint64_t size() const { return count_; }
+
+    std::vector<Task> make(std::uint64_t i) const {
+        return TaskSetGenerator::generate_batch(base_, first_set_ + i, 1).task_set(0);
+    }
+
+    // Identità della sorgente (BatchConfig::campaign_fingerprint).
+    std::string describe() const {
+        return "counter_sets " + describe_generator(base_) + " seed=" + std::to_string(base_.seed) +
+               " first_set=" + std::to_string(first_set_) + " count=" + std::to_string(count_);
+    }
+
+private:
+    GeneratorConfig base_;
+    std::uint64_t first_set_;
+    std::uint64_t count_;
 };
 
-} // namespace rt
\ No newline at end of file
+} // namespace rt
@@ -0,0 +1,117 @@
+// thread_pool.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Pool di worker con work stealing per eseguire N elementi indipendenti.
+// - ogni worker parte da un blocco contiguo di indici (deque locale)
+// - il proprietario estrae dalla testa, i worker inattivi rubano dalla coda altrui
+// Utile quando il costo per elemento varia molto (es. horizon diversi tra task set).
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <optional>
+#include <cstddef>
+#include <algorithm>
+
+namespace rt {
+
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(std::size_t workers)
+        : workers_(workers == 0 ? default_workers() : workers) {}
+
+    static std::size_t default_workers() {
+        const unsigned hw = std::thread::hardware_concurrency();
+        return hw > 0 ? hw : 1;
+    }
+
+    std::size_t workers() const { return workers_; }
+
+    // Esegue fn(item, worker) per ogni item in [0, n_items), bloccando fino al termine.
+    // La prima eccezione lanciata da un worker interrompe la distribuzione e viene rilanciata.
+    template <typename F>
+    void run(std::size_t n_items, F&& fn) {
+        if (n_items == 0) return;
+
+        const std::size_t n_workers = std::min(workers_, n_items);
+        std::vector<std::unique_ptr<LocalQueue>> queues;
+        queues.reserve(n_workers);
+        for (std::size_t w = 0; w < n_workers; ++w) {
+            auto q = std::make_unique<LocalQueue>();
+            const std::size_t begin = w * n_items / n_workers;
+            const std::size_t end = (w + 1) * n_items / n_workers;
+            for (std::size_t i = begin; i < end; ++i) q->items.push_back(i);
+            queues.push_back(std::move(q));
+        }
+
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto worker_loop = [&](std::size_t self) {
+            while (!failed.load(std::memory_order_relaxed)) {
+                std::optional<std::size_t> item = pop_local(*queues[self]);
+                if (!item) item = steal(queues, self);
+                if (!item) return; // tutte le deque sono vuote
+
+                try {
+                    fn(*item, self);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(n_workers);
+            for (std::size_t w = 0; w < n_workers; ++w) {
+                threads.emplace_back(worker_loop, w);
+            }
+        } // join
+
+        if (error) std::rethrow_exception(error);
+    }
+
+private:
+    struct LocalQueue {
+        std::mutex m;
+        std::deque<std::size_t> items;
+    };
+
+    static std::optional<std::size_t> pop_local(LocalQueue& q) {
+        std::lock_guard<std::mutex> lock(q.m);
+        if (q.items.empty()) return std::nullopt;
+        const std::size_t i = q.items.front();
+        q.items.pop_front();
+        return i;
+    }
+
+    static std::optional<std::size_t> steal(std::vector<std::unique_ptr<LocalQueue>>& queues,
+                                            std::size_t self) {
+        // Le deque non vengono mai riempite dopo l'avvio: un giro completo senza
+        // trovare nulla significa che non resta lavoro da distribuire.
+        for (std::size_t k = 1; k < queues.size(); ++k) {
+            LocalQueue& victim = *queues[(self + k) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.m);
+            if (!victim.items.empty()) {
+                const std::size_t i = victim.items.back();
+                victim.items.pop_back();
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::size_t workers_;
+};
+
+} // namespace rt
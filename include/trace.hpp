@@ -0,0 +1,486 @@
+// trace.hpp
+// Created by Francesco on 17/02/2026.
+//
+// Traccia binaria della timeline di simulazione (alternativa a basso costo alla stampa
+// per tick su std::cout):
+// - TraceRecord: record a dimensione fissa (release, start, run, preempt, finish, idle,
+//   overhead di context switch)
+// - TraceRecorder: buffer preallocato; esecuzione continua dello stesso job e tick idle
+//   consecutivi sono codificati run-length (un record con durata `span`).
+//   Il buffer è un ring (ultimi N record in memoria) oppure viene svuotato a blocchi su
+//   un sink o su file (.rttrace) senza perdere record.
+// - decodifica offline: timeline testuale identica a quella di debug_timeline e JSON
+//   Chrome trace (chrome://tracing, Perfetto) con un thread per task.
+//
+// Layout del file .rttrace (little-endian nativo):
+// - header fisso (64 byte): magic, versione, numero task, horizon, record scartati
+// - tabella dei task (48 byte per task: id, T, D, C, P, O)
+// - record TraceRecord fino a fine file
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <iomanip>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "task.hpp"
+
+namespace rt {
+
+enum class TraceKind : std::uint8_t {
+    Release = 0,    // aux = deadline assoluta
+    Start = 1,      // primo tick eseguito dal job
+    Run = 2,        // esecuzione continua per `span` tick; aux = residuo all'inizio
+    Preempt = 3,    // il job viene sospeso (un altro job va in esecuzione)
+    Finish = 4,     // completamento a `time`; aux = deadline assoluta
+    Idle = 5,       // CPU inattiva per `span` tick
+    Overhead = 6    // overhead di context switch per `span` tick verso il job indicato
+};
+
+struct TraceRecord {
+    tick_t time = 0;
+    tick_t span = 0;
+    tick_t aux = 0;
+    std::int32_t task = -1;     // task_index (-1 per Idle)
+    std::int32_t job = -1;      // job_index
+    TraceKind kind = TraceKind::Idle;
+    std::uint8_t reserved[7] = {};
+};
+
+static_assert(sizeof(TraceRecord) == 40, "TraceRecord: unexpected padding");
+
+namespace tracefmt {
+
+inline constexpr char magic[8] = {'R', 'T', 'T', 'R', 'A', 'C', 'E', '1'};
+inline constexpr std::uint32_t endian_tag = 0x01020304u;
+inline constexpr std::uint32_t version = 1;
+inline constexpr std::size_t header_size = 64;
+inline constexpr std::size_t task_entry_size = 48;
+
+inline std::vector<char> header(const std::vector<Task>& tasks, tick_t horizon, std::uint64_t dropped) {
+    std::vector<char> out(header_size + tasks.size() * task_entry_size, 0);
+    auto put = [&](std::size_t pos, auto v) { std::memcpy(out.data() + pos, &v, sizeof(v)); };
+
+    std::memcpy(out.data(), magic, sizeof(magic));
+    put(8, endian_tag);
+    put(12, version);
+    put(16, static_cast<std::uint64_t>(tasks.size()));
+    put(24, static_cast<std::int64_t>(horizon));
+    put(32, dropped);
+    put(40, static_cast<std::uint32_t>(sizeof(TraceRecord)));
+
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        const std::size_t e = header_size + i * task_entry_size;
+        const Task& t = tasks[i];
+        put(e + 0, static_cast<std::int64_t>(t.id));
+        put(e + 8, static_cast<std::int64_t>(t.period));
+        put(e + 16, static_cast<std::int64_t>(t.deadline));
+        put(e + 24, static_cast<std::int64_t>(t.wcet));
+        put(e + 32, static_cast<std::int64_t>(t.priority));
+        put(e + 40, static_cast<std::int64_t>(t.offset));
+    }
+    return out;
+}
+
+} // namespace tracefmt
+
+class TraceRecorder {
+public:
+    using Sink = std::function<void(const TraceRecord*, std::size_t)>;
+
+    static constexpr std::size_t default_capacity = std::size_t{1} << 16;
+
+    // Ring buffer in memoria: restano gli ultimi `capacity` record (vedi dropped()).
+    explicit TraceRecorder(std::size_t capacity = default_capacity)
+        : buf_(check_capacity(capacity)) {}
+
+    // Buffer svuotato su `sink` quando è pieno e a fine run.
+    explicit TraceRecorder(Sink sink, std::size_t capacity = default_capacity)
+        : buf_(check_capacity(capacity)), sink_(std::move(sink)) {}
+
+    // File .rttrace riscritto a ogni run (begin): header, tabella task e record a blocchi.
+    explicit TraceRecorder(const std::string& path, std::size_t capacity = default_capacity)
+        : buf_(check_capacity(capacity)), path_(path)
+    {
+        sink_ = [this](const TraceRecord* r, std::size_t n) {
+            file_.write(reinterpret_cast<const char*>(r), static_cast<std::streamsize>(n * sizeof(TraceRecord)));
+            if (!file_) throw std::runtime_error("Error writing trace file: " + path_);
+        };
+    }
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    // Inizio di una run: azzera il buffer (e riscrive l'header se su file).
+    void begin(const std::vector<Task>& tasks, tick_t horizon) {
+        tasks_ = tasks;
+        horizon_ = horizon;
+        seq_ = 0;
+        drained_ = 0;
+        open_ = none;
+        running_task_ = -1;
+        running_job_ = -1;
+
+        if (!path_.empty()) {
+            file_.close();
+            file_.open(path_, std::ios::binary | std::ios::trunc);
+            if (!file_) throw std::runtime_error("Cannot open trace file: " + path_);
+            const auto head = tracefmt::header(tasks_, horizon_, 0);
+            file_.write(head.data(), static_cast<std::streamsize>(head.size()));
+        }
+    }
+
+    // Fine della run: consegna i record rimasti al sink / file.
+    void end() {
+        if (sink_) drain();
+        if (file_.is_open()) {
+            file_.close();
+            if (file_.fail()) throw std::runtime_error("Error writing trace file: " + path_);
+        }
+    }
+
+    void release(tick_t t, std::int32_t task, std::int32_t job, tick_t abs_deadline) {
+        push({t, 0, abs_deadline, task, job, TraceKind::Release});
+    }
+
+    void start(tick_t t, std::int32_t task, std::int32_t job) {
+        push({t, 0, 0, task, job, TraceKind::Start});
+    }
+
+    // Il job va in esecuzione in `t`: se un altro job era in esecuzione e non è terminato,
+    // registra la sua preemption.
+    void dispatch(tick_t t, std::int32_t task, std::int32_t job) {
+        if (running_task_ >= 0 && (running_task_ != task || running_job_ != job)) {
+            push({t, 0, 0, running_task_, running_job_, TraceKind::Preempt});
+        }
+        running_task_ = task;
+        running_job_ = job;
+    }
+
+    // Esecuzione di `ticks` tick da `t`; `remaining` è il residuo prima dell'esecuzione.
+    void run(tick_t t, tick_t ticks, std::int32_t task, std::int32_t job, tick_t remaining) {
+        dispatch(t, task, job);
+        extend_or_push({t, ticks, remaining, task, job, TraceKind::Run});
+    }
+
+    // Overhead di context switch verso il job (già registrato con dispatch).
+    void overhead(tick_t t, tick_t ticks, std::int32_t task, std::int32_t job) {
+        extend_or_push({t, ticks, 0, task, job, TraceKind::Overhead});
+    }
+
+    void finish(tick_t t, std::int32_t task, std::int32_t job, tick_t abs_deadline) {
+        running_task_ = -1;
+        running_job_ = -1;
+        open_ = none;
+        push({t, 0, abs_deadline, task, job, TraceKind::Finish});
+    }
+
+    void idle(tick_t t, tick_t ticks) {
+        extend_or_push({t, ticks, 0, -1, -1, TraceKind::Idle});
+    }
+
+    // Record registrati nella run corrente (con il ring, anche quelli poi sovrascritti).
+    std::uint64_t recorded() const { return seq_; }
+
+    // Record sovrascritti dal ring buffer (0 con sink o file).
+    std::uint64_t dropped() const {
+        return (!sink_ && seq_ > buf_.size()) ? seq_ - buf_.size() : 0;
+    }
+
+    // Record ancora nel buffer, dal più vecchio.
+    std::vector<TraceRecord> records() const {
+        std::vector<TraceRecord> out;
+        const std::uint64_t first = std::max<std::uint64_t>(drained_, seq_ - std::min<std::uint64_t>(seq_, buf_.size()));
+        out.reserve(static_cast<std::size_t>(seq_ - first));
+        for (std::uint64_t s = first; s < seq_; ++s) out.push_back(buf_[s % buf_.size()]);
+        return out;
+    }
+
+    // Scrive il contenuto del ring buffer come file .rttrace.
+    void write_file(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("Cannot open trace file: " + path);
+        const auto head = tracefmt::header(tasks_, horizon_, dropped());
+        out.write(head.data(), static_cast<std::streamsize>(head.size()));
+        const auto recs = records();
+        out.write(reinterpret_cast<const char*>(recs.data()),
+                  static_cast<std::streamsize>(recs.size() * sizeof(TraceRecord)));
+        out.close();
+        if (out.fail()) throw std::runtime_error("Error writing trace file: " + path);
+    }
+
+private:
+    static constexpr std::uint64_t none = std::numeric_limits<std::uint64_t>::max();
+
+    static std::size_t check_capacity(std::size_t capacity) {
+        if (capacity == 0) throw std::invalid_argument("TraceRecorder: capacity must be > 0");
+        return capacity;
+    }
+
+    // Ultimo record con durata, se è ancora nel buffer e può essere esteso.
+    TraceRecord* open_record() {
+        if (open_ == none || open_ < drained_ || seq_ - open_ > buf_.size()) return nullptr;
+        return &buf_[open_ % buf_.size()];
+    }
+
+    // Run-length: estende il record aperto se è dello stesso tipo e job e termina in r.time.
+    void extend_or_push(const TraceRecord& r) {
+        if (TraceRecord* o = open_record(); o != nullptr && o->kind == r.kind &&
+            o->task == r.task && o->job == r.job && o->time + o->span == r.time) {
+            o->span += r.span;
+            return;
+        }
+        open_ = seq_;
+        push(r);
+    }
+
+    void push(const TraceRecord& r) {
+        if (sink_ && seq_ - drained_ == buf_.size()) drain();
+        buf_[seq_ % buf_.size()] = r;
+        seq_++;
+    }
+
+    // Consegna i record [drained_, seq_) in al più due blocchi contigui.
+    void drain() {
+        const std::size_t cap = buf_.size();
+        while (drained_ < seq_) {
+            const std::size_t pos = drained_ % cap;
+            const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(seq_ - drained_, cap - pos));
+            sink_(buf_.data() + pos, n);
+            drained_ += n;
+        }
+    }
+
+    std::vector<TraceRecord> buf_;
+    Sink sink_;
+    std::string path_;
+    std::ofstream file_;
+
+    std::vector<Task> tasks_;
+    tick_t horizon_ = 0;
+
+    std::uint64_t seq_ = 0;         // record registrati
+    std::uint64_t drained_ = 0;     // record già consegnati al sink
+    std::uint64_t open_ = none;     // record Run/Idle/Overhead estendibile
+    std::int32_t running_task_ = -1;
+    std::int32_t running_job_ = -1;
+};
+
+// Rende i record come la timeline testuale storica (una riga per tick: RUN, IDLE o SWITCH).
+// Riceve i record in streaming (es. come sink di TraceRecorder): la riga dell'ultimo tick
+// di un Run riporta FINISH se il record successivo è il completamento del job.
+class TimelineTextRenderer {
+public:
+    TimelineTextRenderer(std::ostream& os, std::vector<id_t> task_ids)
+        : os_(os), task_ids_(std::move(task_ids)) {}
+
+    void consume(const TraceRecord* r, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) consume(r[i]);
+    }
+
+    void consume(const TraceRecord& r) {
+        switch (r.kind) {
+            case TraceKind::Run:
+                flush();
+                pending_ = r;
+                has_pending_ = true;
+                break;
+            case TraceKind::Finish:
+                if (has_pending_ && pending_.task == r.task && pending_.job == r.job &&
+                    pending_.time + pending_.span == r.time) {
+                    render_run(pending_, &r);
+                    has_pending_ = false;
+                }
+                break;
+            case TraceKind::Idle:
+                flush();
+                for (tick_t k = r.time; k < r.time + r.span; ++k) {
+                    os_ << "t=" << std::setw(4) << k << "  IDLE\n";
+                }
+                break;
+            case TraceKind::Overhead:
+                flush();
+                for (tick_t k = r.time; k < r.time + r.span; ++k) {
+                    os_ << "t=" << std::setw(4) << k
+                        << "  SWITCH task_id=" << std::setw(3) << task_id(r.task)
+                        << "  job=" << std::setw(3) << r.job << "\n";
+                }
+                break;
+            case TraceKind::Release:
+            case TraceKind::Start:
+            case TraceKind::Preempt:
+                break;
+        }
+    }
+
+    // Da chiamare dopo l'ultimo record.
+    void flush() {
+        if (!has_pending_) return;
+        render_run(pending_, nullptr);
+        has_pending_ = false;
+    }
+
+private:
+    id_t task_id(std::int32_t task) const {
+        return (task >= 0 && static_cast<std::size_t>(task) < task_ids_.size())
+            ? task_ids_[static_cast<std::size_t>(task)] : task;
+    }
+
+    void render_run(const TraceRecord& run, const TraceRecord* finish) {
+        for (tick_t k = 0; k < run.span; ++k) {
+            os_ << "t=" << std::setw(4) << run.time + k
+                << "  RUN  task_id=" << std::setw(3) << task_id(run.task)
+                << "  job=" << std::setw(3) << run.job
+                << "  rem->" << std::setw(3) << run.aux - (k + 1);
+
+            if (finish != nullptr && k + 1 == run.span) {
+                const tick_t late = finish->time - finish->aux;
+                os_ << "  FINISH@" << finish->time
+                    << "  dl=" << finish->aux
+                    << "  late=" << (late > 0 ? late : 0);
+            }
+            os_ << "\n";
+        }
+    }
+
+    std::ostream& os_;
+    std::vector<id_t> task_ids_;
+    TraceRecord pending_;
+    bool has_pending_ = false;
+};
+
+// Contenuto di un file .rttrace.
+struct TraceFile {
+    std::vector<Task> tasks;
+    tick_t horizon = 0;
+    std::uint64_t dropped = 0;
+    std::vector<TraceRecord> records;
+};
+
+inline TraceFile read_trace_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Cannot open trace file: " + path);
+    const std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    auto get = [&](std::size_t pos, auto v) {
+        if (pos + sizeof(v) > data.size()) throw std::runtime_error("Truncated trace file: " + path);
+        std::memcpy(&v, data.data() + pos, sizeof(v));
+        return v;
+    };
+
+    if (data.size() < tracefmt::header_size ||
+        std::memcmp(data.data(), tracefmt::magic, sizeof(tracefmt::magic)) != 0) {
+        throw std::runtime_error("Not a trace file: " + path);
+    }
+    if (get(8, std::uint32_t{}) != tracefmt::endian_tag) {
+        throw std::runtime_error("Trace file has a different byte order: " + path);
+    }
+    if (get(12, std::uint32_t{}) != tracefmt::version ||
+        get(40, std::uint32_t{}) != sizeof(TraceRecord)) {
+        throw std::runtime_error("Unsupported trace file version: " + path);
+    }
+
+    TraceFile f;
+    const auto n_tasks = get(16, std::uint64_t{});
+    f.horizon = get(24, std::int64_t{});
+    f.dropped = get(32, std::uint64_t{});
+
+    // n_tasks arriva dal file: va verificato prima di allocare la tabella dei task.
+    if (n_tasks > (data.size() - tracefmt::header_size) / tracefmt::task_entry_size) {
+        throw std::runtime_error("Truncated trace file: " + path);
+    }
+    f.tasks.resize(static_cast<std::size_t>(n_tasks));
+    for (std::size_t i = 0; i < f.tasks.size(); ++i) {
+        const std::size_t e = tracefmt::header_size + i * tracefmt::task_entry_size;
+        Task& t = f.tasks[i];
+        t.id = static_cast<id_t>(get(e + 0, std::int64_t{}));
+        t.period = get(e + 8, std::int64_t{});
+        t.deadline = get(e + 16, std::int64_t{});
+        t.wcet = get(e + 24, std::int64_t{});
+        t.priority = static_cast<prio_t>(get(e + 32, std::int64_t{}));
+        t.offset = get(e + 40, std::int64_t{});
+    }
+
+    const std::size_t begin = tracefmt::header_size + f.tasks.size() * tracefmt::task_entry_size;
+    if (begin > data.size() || (data.size() - begin) % sizeof(TraceRecord) != 0) {
+        throw std::runtime_error("Truncated trace file: " + path);
+    }
+    f.records.resize((data.size() - begin) / sizeof(TraceRecord));
+    if (!f.records.empty()) {
+        std::memcpy(f.records.data(), data.data() + begin, f.records.size() * sizeof(TraceRecord));
+    }
+    return f;
+}
+
+inline void write_text_timeline(std::ostream& os, const TraceFile& f) {
+    std::vector<id_t> ids;
+    for (const auto& t : f.tasks) ids.push_back(t.id);
+    TimelineTextRenderer text(os, std::move(ids));
+    text.consume(f.records.data(), f.records.size());
+    text.flush();
+}
+
+// JSON Chrome trace: un thread per task (più uno per l'idle), 1 tick = 1 ms.
+// Run, Idle e Overhead sono eventi "X" (con durata), gli altri eventi sono istantanei.
+inline void write_chrome_trace(std::ostream& os, const TraceFile& f) {
+    const auto idle_tid = static_cast<std::int64_t>(f.tasks.size());
+    auto us = [](tick_t t) { return t * 1000; };
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (std::size_t i = 0; i < f.tasks.size(); ++i) {
+        const Task& t = f.tasks[i];
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i
+           << ",\"args\":{\"name\":\"task " << t.id << " (P=" << t.priority << " T=" << t.period
+           << " D=" << t.deadline << " C=" << t.wcet << ")\"}},\n";
+    }
+    os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << idle_tid
+       << ",\"args\":{\"name\":\"IDLE\"}}";
+
+    for (const TraceRecord& r : f.records) {
+        os << ",\n";
+        switch (r.kind) {
+            case TraceKind::Run:
+                os << "{\"name\":\"job " << r.job << "\",\"cat\":\"run\",\"ph\":\"X\",\"pid\":0,\"tid\":" << r.task
+                   << ",\"ts\":" << us(r.time) << ",\"dur\":" << us(r.span)
+                   << ",\"args\":{\"remaining\":" << r.aux << "}}";
+                break;
+            case TraceKind::Idle:
+                os << "{\"name\":\"idle\",\"cat\":\"idle\",\"ph\":\"X\",\"pid\":0,\"tid\":" << idle_tid
+                   << ",\"ts\":" << us(r.time) << ",\"dur\":" << us(r.span) << "}";
+                break;
+            case TraceKind::Overhead:
+                os << "{\"name\":\"switch\",\"cat\":\"overhead\",\"ph\":\"X\",\"pid\":0,\"tid\":" << r.task
+                   << ",\"ts\":" << us(r.time) << ",\"dur\":" << us(r.span)
+                   << ",\"args\":{\"job\":" << r.job << "}}";
+                break;
+            case TraceKind::Release:
+            case TraceKind::Finish: {
+                const bool release = (r.kind == TraceKind::Release);
+                os << "{\"name\":\"" << (release ? "release" : "finish") << "\",\"cat\":\"job\",\"ph\":\"i\",\"s\":\"t\""
+                   << ",\"pid\":0,\"tid\":" << r.task << ",\"ts\":" << us(r.time)
+                   << ",\"args\":{\"job\":" << r.job << ",\"deadline\":" << r.aux;
+                if (!release) os << ",\"late\":" << std::max<tick_t>(0, r.time - r.aux);
+                os << "}}";
+                break;
+            }
+            case TraceKind::Start:
+            case TraceKind::Preempt:
+                os << "{\"name\":\"" << (r.kind == TraceKind::Start ? "start" : "preempt")
+                   << "\",\"cat\":\"job\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":" << r.task
+                   << ",\"ts\":" << us(r.time) << ",\"args\":{\"job\":" << r.job << "}}";
+                break;
+        }
+    }
+    os << "\n]}\n";
+}
+
+} // namespace rt
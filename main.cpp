@@ -5,7 +5,6 @@
 // Pensato per campagne lunghe: niente output dettagliato su terminale, solo avanzamento batch.
 
 #include <iostream>
-#include <vector>
 #include <filesystem>
 #include <cstdint>
 
@@ -24,27 +23,27 @@ int main() {
 
     const std::string summary_csv = (out_dir / "summary.csv").string();
     const std::string per_task_csv = (out_dir / "per_task.csv").string();
-
-    // Rimuove eventuali file precedenti per evitare di accumulare righe vecchie.
-    std::filesystem::remove(summary_csv);
-    std::filesystem::remove(per_task_csv);
+    const std::string distributions_csv = (out_dir / "distributions.csv").string();
+    const std::string journal = (out_dir / "summary.journal").string();
+
+    // Con il journal di una campagna interrotta si riprende dall'ultima run registrata;
+    // altrimenti rimuove eventuali file precedenti per evitare di accumulare righe vecchie.
+    if (!std::filesystem::exists(journal)) {
+        std::filesystem::remove(summary_csv);
+        std::filesystem::remove(per_task_csv);
+        std::filesystem::remove(distributions_csv);
+    }
 
     // =========================
-    // Generazione task set
+    // Generazione task set (lazy: seed 1001..1200, un task set per seed)
     // =========================
-    std::vector<std::vector<Task>> tasksets;
-    tasksets.reserve(200);
-
-    for (std::uint32_t s = 1; s <= 200; ++s) {
-        GeneratorConfig gcfg;
-        gcfg.n_tasks = 8;
-        gcfg.Tmin = 10;
-        gcfg.Tmax = 150;
-        gcfg.utilization_target = 0.85;
-        gcfg.seed = 1000 + s;
-
-        tasksets.push_back(TaskSetGenerator::generate(gcfg));
-    }
+    GeneratorConfig gcfg;
+    gcfg.n_tasks = 8;
+    gcfg.Tmin = 10;
+    gcfg.Tmax = 150;
+    gcfg.utilization_target = 0.85;
+
+    const SeedRangeSource tasksets(gcfg, 1001, 200);
 
     // =========================
     // Configurazione batch
@@ -55,6 +54,12 @@ int main() {
     // Limite massimo all'horizon per evitare iperperiodi ingestibili.
     cfg.max_horizon = 200000;
 
+    // Motore a eventi: stesse metriche del tick-loop, costo proporzionale al numero di job.
+    cfg.engine = SimEngine::Event;
+
+    // Tutti i core disponibili; le righe CSV restano in ordine di run_id.
+    cfg.workers = 0;
+
     // Nessun output dettagliato durante le singole run.
     cfg.debug_timeline = false;
     cfg.print_input_each_run = false;
@@ -64,18 +69,28 @@ int main() {
     cfg.print_progress = true;
     cfg.progress_every_runs = 1;
 
+    // Quantili di response time / lateness / ritardo di avvio su tutta la campagna.
+    cfg.export_distributions = true;
+    cfg.distributions_csv_path = distributions_csv;
+
+    // Checkpoint nel journal (results/summary.journal): un'interruzione non perde le run già esportate.
+    // Un journal di una campagna con parametri diversi viene rifiutato.
+    cfg.checkpoint = true;
+    cfg.campaign_fingerprint = tasksets.describe();
+
     std::cout << "Starting batch execution...\n";
     std::cout << "Output directory: " << out_dir.string() << "\n";
     std::cout << "Task sets: " << tasksets.size() << "\n";
     std::cout << "Policy: FPP\n";
     std::cout << "Horizon mode: Hyperperiod (capped at " << cfg.max_horizon << " ticks)\n\n";
 
-    BatchRunner::run(tasksets, cfg, summary_csv, per_task_csv);
+    BatchRunner::run_stream(tasksets, cfg, summary_csv, per_task_csv);
 
     std::cout << "\nBatch finished.\n";
     std::cout << "Generated files:\n";
     std::cout << "  - " << summary_csv << "\n";
     std::cout << "  - " << per_task_csv << "\n";
+    std::cout << "  - " << distributions_csv << "\n";
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,131 @@
+// campaign.cpp
+// Created by Francesco on 17/02/2026.
+//
+// Campagne suddivise in shard (vedi campaign.hpp):
+// - run:   esegue uno shard (un processo per shard, anche su macchine diverse)
+// - merge: fonde gli shard completati nei CSV canonici ordinati per run_id
+// - local: lancia tutti gli shard come processi separati su questa macchina e poi li fonde
+//
+// Uso: campaign run   <campaign.txt> <out_dir> <shard> <n_shards> [workers] [--quiet]
+//      campaign merge <campaign.txt> <out_dir> <n_shards>
+//      campaign local <campaign.txt> <out_dir> <n_shards> [workers_per_shard]
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+#include <charconv>
+
+#include "../include/campaign.hpp"
+
+namespace {
+
+int usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0 << " run   <campaign.txt> <out_dir> <shard> <n_shards> [workers] [--quiet]\n"
+              << "       " << argv0 << " merge <campaign.txt> <out_dir> <n_shards>\n"
+              << "       " << argv0 << " local <campaign.txt> <out_dir> <n_shards> [workers_per_shard]\n";
+    return 2;
+}
+
+// Intero non negativo, senza caratteri residui (es. "4x" o "-1" sono errori).
+std::size_t parse_count(const std::string& arg, const char* what) {
+    std::size_t v = 0;
+    const auto res = std::from_chars(arg.data(), arg.data() + arg.size(), v);
+    if (arg.empty() || res.ec != std::errc() || res.ptr != arg.data() + arg.size()) {
+        throw std::invalid_argument(std::string("invalid ") + what + ": '" + arg + "'");
+    }
+    return v;
+}
+
+// Argomento per la shell di std::system, passato letteralmente (niente espansioni di
+// variabili o comandi): apici singoli in POSIX, doppi apici in cmd.exe.
+std::string quoted(const std::string& s) {
+#ifdef _WIN32
+    if (s.find('"') != std::string::npos) throw std::invalid_argument("Unsupported '\"' in path: " + s);
+    return "\"" + s + "\"";
+#else
+    std::string out = "'";
+    for (char c : s) {
+        if (c == '\'') out += "'\\''";
+        else out.push_back(c);
+    }
+    return out + "'";
+#endif
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    using namespace rt;
+
+    if (argc < 5) return usage(argv[0]);
+    const std::string command = argv[1];
+
+    try {
+        const CampaignSpec spec = load_campaign(argv[2]);
+        const std::filesystem::path out_dir = argv[3];
+
+        if (command == "run") {
+            if (argc < 6 || argc > 8) return usage(argv[0]);
+            const std::size_t index = parse_count(argv[4], "shard index");
+            const std::size_t n_shards = parse_count(argv[5], "number of shards");
+
+            BatchConfig cfg;
+            cfg.workers = (argc > 6 && std::string(argv[6]) != "--quiet") ? parse_count(argv[6], "workers") : 0;
+            cfg.print_progress = std::string(argv[argc - 1]) != "--quiet";
+
+            const CampaignShard shard = shard_of(spec, index, n_shards);
+            if (cfg.print_progress) {
+                std::cout << "Shard " << index << "/" << n_shards << ": runs " << shard.first_run
+                          << ".." << shard.first_run + shard.runs << " (seeds from "
+                          << spec.first_seed + shard.first_run << ")\n";
+            }
+            run_shard(spec, index, n_shards, out_dir, cfg);
+            return 0;
+        }
+
+        if (command == "merge") {
+            if (argc != 5) return usage(argv[0]);
+            merge_shards(spec, parse_count(argv[4], "number of shards"), out_dir);
+            std::cout << "Merged into " << (out_dir / "summary.csv").string() << " and "
+                      << (out_dir / "per_task.csv").string() << "\n";
+            return 0;
+        }
+
+        if (command == "local") {
+            if (argc < 5 || argc > 6) return usage(argv[0]);
+            const std::size_t n_shards = parse_count(argv[4], "number of shards");
+            const std::size_t workers = (argc > 5) ? parse_count(argv[5], "workers") : 1;
+            if (n_shards == 0) return usage(argv[0]);
+
+            // Un processo per shard, come su macchine diverse.
+            std::vector<int> status(n_shards, 0);
+            std::vector<std::thread> launchers;
+            for (std::size_t i = 0; i < n_shards; ++i) {
+                const std::string cmd = quoted(argv[0]) + " run " + quoted(argv[2]) + " " + quoted(argv[3]) +
+                                        " " + std::to_string(i) + " " + std::to_string(n_shards) +
+                                        " " + std::to_string(workers) + " --quiet";
+                launchers.emplace_back([cmd, &status, i] { status[i] = std::system(cmd.c_str()); });
+            }
+            for (auto& t : launchers) t.join();
+
+            for (std::size_t i = 0; i < n_shards; ++i) {
+                if (status[i] != 0) {
+                    std::cerr << "Shard " << i << " failed (status " << status[i] << ")\n";
+                    return 1;
+                }
+            }
+            merge_shards(spec, n_shards, out_dir);
+            std::cout << "Ran " << n_shards << " shards, merged into " << out_dir.string() << "\n";
+            return 0;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return usage(argv[0]);
+}
@@ -0,0 +1,31 @@
+// results_to_csv.cpp
+// Created by Francesco on 17/02/2026.
+//
+// Convertitore da formato binario colonnare (.rtcol) al layout CSV attuale,
+// così gli script esistenti continuano a funzionare sui risultati binari.
+//
+// Uso: results_to_csv <input.rtcol> <output.csv> [<input.rtcol> <output.csv> ...]
+
+#include <iostream>
+#include <exception>
+
+#include "../include/binary_export.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3 || (argc % 2) != 1) {
+        std::cerr << "Usage: " << argv[0] << " <input.rtcol> <output.csv> [<input.rtcol> <output.csv> ...]\n";
+        return 2;
+    }
+
+    try {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            rt::binary_to_csv(argv[i], argv[i + 1]);
+            std::cout << argv[i] << " -> " << argv[i + 1] << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+// trace_decode.cpp
+// Created by Francesco on 17/02/2026.
+//
+// Decodifica offline di una traccia binaria (.rttrace, vedi trace.hpp):
+// - text:   timeline testuale, identica a quella stampata con debug_timeline
+// - chrome: JSON Chrome trace (chrome://tracing, Perfetto), un thread per task
+//
+// Uso: trace_decode <input.rttrace> <text|chrome> [output]   (default: stdout)
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <exception>
+
+#include "../include/trace.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3 || argc > 4) {
+        std::cerr << "Usage: " << argv[0] << " <input.rttrace> <text|chrome> [output]\n";
+        return 2;
+    }
+
+    const std::string format = argv[2];
+    if (format != "text" && format != "chrome") {
+        std::cerr << "Unknown format: " << format << " (expected text or chrome)\n";
+        return 2;
+    }
+
+    try {
+        const rt::TraceFile trace = rt::read_trace_file(argv[1]);
+        if (trace.dropped > 0) {
+            std::cerr << "[NOTE] " << trace.dropped << " records were overwritten by the ring buffer\n";
+        }
+
+        std::ofstream file;
+        if (argc == 4) {
+            file.open(argv[3], std::ios::trunc);
+            if (!file) throw std::runtime_error(std::string("Cannot open output file: ") + argv[3]);
+        }
+        std::ostream& out = (argc == 4) ? file : std::cout;
+
+        if (format == "text") {
+            rt::write_text_timeline(out, trace);
+        } else {
+            rt::write_chrome_trace(out, trace);
+        }
+
+        out.flush();
+        if (!out) throw std::runtime_error("Error writing output");
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}